@@ -21,9 +21,14 @@
 #include "private/multisplitter/Widget.h"
 #include "private/multisplitter/Item_p.h"
 #include "private/DockRegistry_p.h"
+#include "private/DockWidgetBase_p.h"
 #include "private/Utils_p.h"
 #include "private/DragController_p.h"
+#include "private/DragStatistics_p.h"
+#include "private/FloatingWindow_p.h"
+#include "private/Frame_p.h"
 #include "FrameworkWidgetFactory.h"
+#include "LayoutUndoStack.h"
 
 #include <QDebug>
 #include <QOperatingSystemVersion>
@@ -52,16 +57,26 @@ public:
     void fixFlags();
 
     QQmlEngine *m_qmlEngine = nullptr;
+    bool m_asynchronousGuestCreation = false;
+    bool m_batchedSeparators = false;
     DockWidgetFactoryFunc m_dockWidgetFactoryFunc = nullptr;
     MainWindowFactoryFunc m_mainWindowFactoryFunc = nullptr;
     TabbingAllowedFunc m_tabbingAllowedFunc = nullptr;
     DropIndicatorAllowedFunc m_dropIndicatorAllowedFunc = nullptr;
+    DragStatisticsFunc m_dragStatisticsFunc = nullptr;
     FrameworkWidgetFactory *m_frameworkWidgetFactory = nullptr;
     Flags m_flags = Flag_Default;
     InternalFlags m_internalFlags = InternalFlag_None;
     CustomizableWidgets m_disabledPaintEvents = CustomizableWidget_None;
     qreal m_draggedWindowOpacity = Q_QNAN;
     int m_mdiPopupThreshold = 250;
+    int m_hibernationTimeout = -1;
+    qint64 m_hibernationBudget = -1;
+    int m_maxLiveTabGuests = -1;
+    int m_framePoolSize = 0;
+    int m_floatingWindowPoolSize = 0;
+    bool m_layoutSnapshotsEnabled = false;
+    int m_layoutUndoLimit = 0;
     bool m_dropIndicatorsInhibited = false;
 #ifdef KDDOCKWIDGETS_QTQUICK
     QtQuickHelpers m_qquickHelpers;
@@ -112,6 +127,7 @@ void Config::setFlags(Flags f)
 
     auto multisplitterFlags = Layouting::Config::self().flags();
     multisplitterFlags.setFlag(Layouting::Config::Flag::LazyResize, d->m_flags & Flag_LazyResize);
+    multisplitterFlags.setFlag(Layouting::Config::Flag::CoalesceLayoutRequests, d->m_flags & Flag_CoalesceLayoutRequests);
     Layouting::Config::self().setFlags(multisplitterFlags);
 }
 
@@ -262,6 +278,26 @@ QQmlEngine *Config::qmlEngine() const
 
     return d->m_qmlEngine;
 }
+
+void Config::setAsynchronousGuestCreation(bool enable)
+{
+    d->m_asynchronousGuestCreation = enable;
+}
+
+bool Config::asynchronousGuestCreation() const
+{
+    return d->m_asynchronousGuestCreation;
+}
+
+void Config::setBatchedSeparators(bool enable)
+{
+    d->m_batchedSeparators = enable;
+}
+
+bool Config::batchedSeparators() const
+{
+    return d->m_batchedSeparators;
+}
 #endif
 
 void Config::Private::fixFlags()
@@ -343,6 +379,86 @@ int Config::mdiPopupThreshold() const
     return d->m_mdiPopupThreshold;
 }
 
+void Config::setHibernationTimeout(int ms)
+{
+    d->m_hibernationTimeout = ms;
+    DockWidgetBase::Private::onHibernationTimeoutChanged();
+}
+
+int Config::hibernationTimeout() const
+{
+    return d->m_hibernationTimeout;
+}
+
+void Config::setHibernationBudget(qint64 budget)
+{
+    d->m_hibernationBudget = budget;
+}
+
+qint64 Config::hibernationBudget() const
+{
+    return d->m_hibernationBudget;
+}
+
+void Config::setMaxLiveTabGuests(int max)
+{
+    d->m_maxLiveTabGuests = max;
+}
+
+int Config::maxLiveTabGuests() const
+{
+    return d->m_maxLiveTabGuests;
+}
+
+void Config::setFramePoolSize(int size)
+{
+    d->m_framePoolSize = size;
+    Frame::trimFramePool(size);
+}
+
+int Config::framePoolSize() const
+{
+    return d->m_framePoolSize;
+}
+
+void Config::setFloatingWindowPoolSize(int size)
+{
+    d->m_floatingWindowPoolSize = size;
+    FloatingWindow::updatePool();
+}
+
+int Config::floatingWindowPoolSize() const
+{
+    return d->m_floatingWindowPoolSize;
+}
+
+void Config::setLayoutSnapshotsEnabled(bool enable)
+{
+    if (enable == d->m_layoutSnapshotsEnabled)
+        return;
+
+    d->m_layoutSnapshotsEnabled = enable;
+
+    // Publish right away, so readers don't get nullptr until the next layout change
+    DockRegistry::self()->publishLayoutSnapshot();
+}
+
+bool Config::layoutSnapshotsEnabled() const
+{
+    return d->m_layoutSnapshotsEnabled;
+}
+
+void Config::setLayoutUndoLimit(int limit)
+{
+    d->m_layoutUndoLimit = limit;
+    LayoutUndoStack::self()->trim();
+}
+
+int Config::layoutUndoLimit() const
+{
+    return d->m_layoutUndoLimit;
+}
+
 void Config::setDropIndicatorsInhibited(bool inhibit) const
 {
     if (d->m_dropIndicatorsInhibited != inhibit) {
@@ -356,6 +472,26 @@ bool Config::dropIndicatorsInhibited() const
     return d->m_dropIndicatorsInhibited;
 }
 
+void Config::setDragStatisticsEnabled(bool enabled)
+{
+    DragStatisticsCollector::self()->setEnabled(enabled);
+}
+
+bool Config::dragStatisticsEnabled() const
+{
+    return DragStatisticsCollector::self()->isEnabled();
+}
+
+void Config::setDragStatisticsFunc(DragStatisticsFunc func)
+{
+    d->m_dragStatisticsFunc = func;
+}
+
+DragStatisticsFunc Config::dragStatisticsFunc() const
+{
+    return d->m_dragStatisticsFunc;
+}
+
 void Config::printDebug()
 {
     qDebug() << "Flags: " << d->m_flags << d->m_internalFlags;
@@ -65,6 +65,11 @@ typedef bool (*DropIndicatorAllowedFunc)(DropLocation location,
 typedef bool (*TabbingAllowedFunc)(const QVector<DockWidgetBase *> &source,
                                    const QVector<DockWidgetBase *> &target);
 
+/// @brief Function called at the end of each drag when drag statistics are enabled
+/// @param statistics The timings and counters gathered during the drag
+/// @sa setDragStatisticsFunc
+typedef void (*DragStatisticsFunc)(const DragStatistics &statistics);
+
 /**
  * @brief Singleton to allow to choose certain behaviours of the framework.
  *
@@ -106,6 +111,10 @@ public:
         Flag_CloseOnlyCurrentTab = 0x20000, ///< The TitleBar's close button will only close the current tab, instead of all of them
         Flag_ShowButtonsOnTabBarIfTitleBarHidden = 0x40000, ///< When using Flag_HideTitleBarWhenTabsVisible the close/float buttons disappear with the title bar. With Flag_ShowButtonsOnTabBarIfHidden they'll be shown in the tab bar.
         Flag_AllowSwitchingTabsViaMenu = 0x80000, ///< Allow switching tabs via a context menu when right clicking on the tab area
+        Flag_CoalesceDragMouseMoves = 0x100000, ///< While dragging, mouse moves are coalesced and only the latest position is processed, once per display frame. Useful with high polling-rate mice.
+        Flag_LightweightDragProxy = 0x200000, ///< While dragging, a translucent snapshot of the window follows the mouse instead of the window itself, which is only moved on drop. Useful with expensive guests, like OpenGL ones. Ignored on Wayland and when the window manager doesn't support translucency.
+        Flag_CoalesceLayoutRequests = 0x400000, ///< Size constraint changes of the dock widgets' guests are applied at most once per display frame, instead of relayouting on every change. Useful with guests that rebuild their contents often.
+        Flag_LazyMainWindowResize = 0x800000, ///< While a main window is being resized its dock widgets keep their geometry. They're only laid out once the resizing pauses. Like Flag_LazyResize, but for the main window's edges. Useful with expensive guests.
         Flag_Default = Flag_AeroSnapWithClientDecos ///< The defaults
     };
     Q_DECLARE_FLAGS(Flags, Flag)
@@ -311,12 +320,72 @@ public:
     ///@warning Not for public consumption, support will be limited.
     void setInternalFlags(InternalFlags flags);
 
+    /// @brief Enables timing of each drag step
+    /// When enabled, each drag accumulates per-phase timings (see DragPhase) which are reported
+    /// at the end of the drag via the function set with setDragStatisticsFunc().
+    /// Disabled by default, in which case the overhead is negligible.
+    void setDragStatisticsEnabled(bool enabled);
+    bool dragStatisticsEnabled() const;
+
+    /// @brief Sets the function to call with the statistics of each finished drag
+    /// Only called if drag statistics are enabled. nullptr by default.
+    /// @sa setDragStatisticsEnabled()
+    void setDragStatisticsFunc(DragStatisticsFunc func);
+    DragStatisticsFunc dragStatisticsFunc() const;
+
     /// @brief Sets the MDI popup threshold. When the layout is MDI and you drag a dock widget
     /// X pixels behond the window's edge, it will float the dock widget.
     /// by default this value is 250px. Use -1 to disable
     void setMDIPopupThreshold(int);
     int mdiPopupThreshold() const;
 
+    /// @brief Sets after how many milliseconds a closed dock widget hibernates its guest widget
+    /// Only applies to dock widgets which opted in via DockWidgetBase::setHibernationFunctions().
+    /// By default this value is -1, meaning time alone doesn't trigger hibernation.
+    /// @sa setHibernationBudget()
+    void setHibernationTimeout(int ms);
+    int hibernationTimeout() const;
+
+    /// @brief Sets the maximum total DockWidgetBase::guestCost() of closed dock widgets which still
+    /// have their guest widget alive. When exceeded, the least recently closed are hibernated first.
+    /// Checked whenever a dock widget is closed. By default this value is -1, meaning no budget.
+    /// @sa setHibernationTimeout()
+    void setHibernationBudget(qint64 budget);
+    qint64 hibernationBudget() const;
+
+    /// @brief Sets how many dock widgets of a tab group keep their guest widget alive
+    /// When a tab becomes current and the limit is exceeded, the least recently current tabs hibernate
+    /// their guest, which is recreated when the tab becomes current again. Only applies to dock widgets
+    /// which opted in via DockWidgetBase::setHibernationFunctions().
+    /// By default this value is -1, meaning all tabs keep their guest.
+    void setMaxLiveTabGuests(int);
+    int maxLiveTabGuests() const;
+
+    /// @brief Sets how many empty frames are kept around for reuse, instead of being deleted
+    /// Docking and undocking constantly creates and destroys frames, with their title bar and tab widget.
+    /// With a pool, the next FrameworkWidgetFactory::createFrame() reuses a hidden frame instead.
+    /// By default this value is 0, meaning empty frames are always deleted.
+    /// @sa FrameworkWidgetFactory::resetFrame()
+    void setFramePoolSize(int);
+    int framePoolSize() const;
+
+    /// @brief Sets how many hidden floating windows are created in advance
+    /// Creating a floating window means creating a native window, which can be slow, right when the
+    /// user starts dragging. Pooled windows are claimed when floating and replenished when the app is idle.
+    /// Only windows with the default flags and parent are pooled. By default this value is 0.
+    void setFloatingWindowPoolSize(int);
+    int floatingWindowPoolSize() const;
+
+    /// @brief Sets whether a LayoutSnapshot is published whenever the layout changes
+    /// Snapshots can be read from any thread, see LayoutSnapshot::current(). By default this is false.
+    void setLayoutSnapshotsEnabled(bool);
+    bool layoutSnapshotsEnabled() const;
+
+    /// @brief Sets how many docking operations LayoutUndoStack remembers
+    /// By default this value is 0, which disables undo.
+    void setLayoutUndoLimit(int);
+    int layoutUndoLimit() const;
+
     /// Prints some debug information
     void printDebug();
 
@@ -324,6 +393,21 @@ public:
     ///@brief Sets the QQmlEngine to use. Applicable only when using QtQuick.
     void setQmlEngine(QQmlEngine *);
     QQmlEngine *qmlEngine() const;
+
+    ///@brief Sets whether DockWidgetQuick::setWidget(const QString &) creates the guest asynchronously
+    /// The QML is incubated without blocking the render loop and the guest is set once it's ready.
+    /// Needs the engine to have an incubation controller, which QQuickView sets, otherwise it's synchronous.
+    /// Applicable only when using QtQuick. Default is false.
+    void setAsynchronousGuestCreation(bool);
+    bool asynchronousGuestCreation() const;
+
+    ///@brief Sets whether the separators of a layout are drawn by a single item instead of one QML item each
+    /// All separators of a layout then share one scene-graph node and one draw call, and hit-testing
+    /// is done without a MouseArea per separator. Separator.qml isn't used in this mode.
+    /// Applicable only when using QtQuick. Default is false.
+    /// Only affects separators created afterwards, so call it before creating any main window.
+    void setBatchedSeparators(bool);
+    bool batchedSeparators() const;
 #endif
 
 private:
@@ -40,6 +40,13 @@
 
 using namespace KDDockWidgets;
 
+/// @brief Closed dock widgets whose guest could be hibernated, least recently closed first
+static QVector<DockWidgetBase *> &hibernationCandidates()
+{
+    static QVector<DockWidgetBase *> s_candidates;
+    return s_candidates;
+}
+
 DockWidgetBase::DockWidgetBase(const QString &name, Options options,
                                LayoutSaverOptions layoutSaverOptions)
     : QWidgetAdapter(nullptr, Qt::Tool)
@@ -56,6 +63,7 @@ DockWidgetBase::DockWidgetBase(const QString &name, Options options,
 
 DockWidgetBase::~DockWidgetBase()
 {
+    hibernationCandidates().removeOne(this);
     DockRegistry::self()->unregisterDockWidget(this);
     delete d;
 }
@@ -156,9 +164,14 @@ void DockWidgetBase::setWidget(QWidgetOrQuick *w)
     }
 
     d->widget = w;
-    if (w)
+    if (w) {
         setSizePolicy(w->sizePolicy());
 
+        // A new guest replaces any hibernated one
+        d->m_isHibernated = false;
+        d->m_hibernatedState.clear();
+    }
+
     Q_EMIT widgetChanged(w);
 }
 
@@ -389,6 +402,8 @@ QStringList DockWidgetBase::affinities() const
 
 void DockWidgetBase::show()
 {
+    d->wakeUp();
+
     if (isWindow() && (d->m_lastPosition->wasFloating() || !d->m_lastPosition->isValid())) {
         // Create the FloatingWindow already, instead of waiting for the show event.
         // This reduces flickering on some platforms
@@ -639,16 +654,6 @@ QPoint DockWidgetBase::Private::defaultCenterPosForFloating()
     return mw->geometry().center();
 }
 
-bool DockWidgetBase::Private::eventFilter(QObject *watched, QEvent *event)
-{
-    const bool isWindowActivate = event->type() == QEvent::WindowActivate;
-    const bool isWindowDeactivate = event->type() == QEvent::WindowDeactivate;
-    if ((isWindowActivate || isWindowDeactivate) && watched == q->window())
-        Q_EMIT q->windowActiveAboutToChange(isWindowActivate);
-
-    return QObject::eventFilter(watched, event);
-}
-
 void DockWidgetBase::Private::updateTitle()
 {
     if (q->isFloating())
@@ -749,6 +754,105 @@ void DockWidgetBase::Private::close()
     if (!m_isMovingToSideBar && (options & DockWidgetBase::Option_DeleteOnClose)) {
         Q_EMIT q->aboutToDeleteOnClose();
         q->deleteLater();
+    } else if (!m_isMovingToSideBar) {
+        scheduleHibernation();
+    }
+}
+
+void DockWidgetBase::Private::scheduleHibernation()
+{
+    if (!m_guestWidgetFactory || !widget || m_isHibernated)
+        return;
+
+    QVector<DockWidgetBase *> &candidates = hibernationCandidates();
+    candidates.removeOne(q);
+    candidates.push_back(q);
+
+    const int timeout = Config::self().hibernationTimeout();
+    if (timeout >= 0) {
+        if (!m_hibernationTimer) {
+            m_hibernationTimer = new QTimer(this);
+            m_hibernationTimer->setSingleShot(true);
+            connect(m_hibernationTimer, &QTimer::timeout, this, &DockWidgetBase::Private::hibernate);
+        }
+        m_hibernationTimer->start(timeout);
+    }
+
+    enforceHibernationBudget();
+}
+
+bool DockWidgetBase::Private::hibernate()
+{
+    hibernationCandidates().removeOne(q);
+
+    if (m_isHibernated || !widget || !m_guestWidgetFactory)
+        return false;
+
+    if (q->isOpen()) {
+        // Open dock widgets can only hibernate while in a non-current tab
+        Frame *frame = this->frame();
+        if (!frame || frame->currentDockWidget() == q)
+            return false;
+    }
+
+    m_hibernatedState = m_guestStateSaver ? m_guestStateSaver(q) : QVariant();
+
+    QWidgetOrQuick *guest = widget;
+    widget = nullptr;
+    m_isHibernated = true;
+    delete guest;
+
+    Q_EMIT q->widgetChanged(nullptr);
+
+    return true;
+}
+
+void DockWidgetBase::Private::wakeUp()
+{
+    hibernationCandidates().removeOne(q);
+    if (m_hibernationTimer)
+        m_hibernationTimer->stop();
+
+    if (!m_isHibernated)
+        return;
+
+    const QVariant state = m_hibernatedState;
+    QWidgetOrQuick *guest = m_guestWidgetFactory ? m_guestWidgetFactory(q, state) : nullptr;
+    if (guest) {
+        q->setWidget(guest);
+    } else {
+        qWarning() << Q_FUNC_INFO << "Could not recreate the hibernated guest widget of" << name;
+    }
+}
+
+void DockWidgetBase::Private::enforceHibernationBudget()
+{
+    const qint64 budget = Config::self().hibernationBudget();
+    if (budget < 0)
+        return;
+
+    QVector<DockWidgetBase *> &candidates = hibernationCandidates();
+    qint64 totalCost = 0;
+    for (DockWidgetBase *dw : qAsConst(candidates))
+        totalCost += dw->d->m_guestCost;
+
+    while (totalCost > budget && !candidates.isEmpty()) {
+        // hibernate() removes it from the candidates
+        DockWidgetBase *dw = candidates.constFirst();
+        totalCost -= dw->d->m_guestCost;
+        dw->d->hibernate();
+    }
+}
+
+void DockWidgetBase::Private::onHibernationTimeoutChanged()
+{
+    if (Config::self().hibernationTimeout() >= 0)
+        return;
+
+    // Time alone no longer triggers hibernation. The budget still applies.
+    for (DockWidgetBase *dw : qAsConst(hibernationCandidates())) {
+        if (QTimer *timer = dw->d->m_hibernationTimer)
+            timer->stop();
     }
 }
 
@@ -830,6 +934,7 @@ void DockWidgetBase::onParentChanged()
 
 void DockWidgetBase::onShown(bool spontaneous)
 {
+    d->wakeUp();
     d->onDockWidgetShown();
     Q_EMIT shown();
 
@@ -952,6 +1057,34 @@ bool DockWidgetBase::isPersistentCentralDockWidget() const
     return d->m_isPersistentCentralDockWidget;
 }
 
+void DockWidgetBase::setHibernationFunctions(GuestStateSaverFunc saver, GuestWidgetFactoryFunc factory)
+{
+    d->m_guestStateSaver = saver;
+    d->m_guestWidgetFactory = factory;
+
+    if (!factory) {
+        // Can't recreate the guest anymore, so don't destroy it
+        hibernationCandidates().removeOne(this);
+        if (d->m_hibernationTimer)
+            d->m_hibernationTimer->stop();
+    }
+}
+
+void DockWidgetBase::setGuestCost(qint64 cost)
+{
+    d->m_guestCost = cost;
+}
+
+qint64 DockWidgetBase::guestCost() const
+{
+    return d->m_guestCost;
+}
+
+bool DockWidgetBase::isHibernated() const
+{
+    return d->m_isHibernated;
+}
+
 LayoutSaver::DockWidget::Ptr DockWidgetBase::Private::serialize() const
 {
     auto ptr = LayoutSaver::DockWidget::dockWidgetForName(q->uniqueName());
@@ -1007,8 +1140,6 @@ DockWidgetBase::Private::Private(const QString &dockName, DockWidgetBase::Option
 
     toggleAction->setCheckable(true);
     floatAction->setCheckable(true);
-
-    qApp->installEventFilter(this);
 }
 
 void DockWidgetBase::Private::addPlaceholderItem(Layouting::Item *item)
@@ -24,6 +24,7 @@
 #include "QWidgetAdapter.h"
 #include "LayoutSaver.h"
 
+#include <QVariant>
 #include <QVector>
 #include <memory>
 
@@ -44,6 +45,7 @@ class MainWindowBase;
 class StateDragging;
 class FrameQuick;
 class DockWidgetQuick;
+class Config;
 class LayoutWidget;
 
 /**
@@ -70,6 +72,16 @@ class DOCKS_EXPORT DockWidgetBase : public QWidget
 public:
     typedef QVector<DockWidgetBase *> List;
 
+    /// @brief Function called before the guest widget is destroyed due to hibernation
+    /// Returns the guest's state, which is later passed to GuestWidgetFactoryFunc.
+    /// @sa setHibernationFunctions()
+    typedef QVariant (*GuestStateSaverFunc)(KDDockWidgets::DockWidgetBase *dockWidget);
+
+    /// @brief Function to recreate a hibernated guest widget, restoring @p state
+    /// @sa setHibernationFunctions()
+    typedef KDDockWidgets::QWidgetOrQuick *(*GuestWidgetFactoryFunc)(KDDockWidgets::DockWidgetBase *dockWidget,
+                                                                     const QVariant &state);
+
     ///@brief DockWidget options to pass at construction time
     enum Option {
         Option_None = 0, ///< No option, the default
@@ -469,6 +481,27 @@ public:
     void setFloatingWindowFlags(FloatingWindowFlags);
     KDDockWidgets::FloatingWindowFlags floatingWindowFlags() const;
 
+    /// @brief Opts this dock widget into guest widget hibernation
+    ///
+    /// While the dock widget is closed its guest widget can be destroyed to save memory, according
+    /// to Config::setHibernationTimeout() and Config::setHibernationBudget(). Just before, @p saver
+    /// is called. When the dock widget is shown again, @p factory recreates the guest, receiving
+    /// the state returned by @p saver.
+    ///
+    /// @p saver can be nullptr if there's no state to save. Passing a nullptr @p factory opts out.
+    /// @sa isHibernated()
+    void setHibernationFunctions(GuestStateSaverFunc saver, GuestWidgetFactoryFunc factory);
+
+    /// @brief Sets how much keeping this dock widget's guest alive while closed costs
+    /// The unit is up to the application, for example bytes. Default is 1.
+    /// @sa Config::setHibernationBudget()
+    void setGuestCost(qint64 cost);
+    qint64 guestCost() const;
+
+    /// @brief Returns whether the guest widget is currently destroyed due to hibernation
+    /// widget() returns nullptr in this case.
+    bool isHibernated() const;
+
 Q_SIGNALS:
 #ifdef KDDOCKWIDGETS_QTWIDGETS
     ///@brief signal emitted when the parent changed
@@ -557,6 +590,7 @@ private:
     friend class KDDockWidgets::MainWindowBase;
     friend class KDDockWidgets::FrameQuick;
     friend class KDDockWidgets::DockWidgetQuick;
+    friend class KDDockWidgets::Config;
 
     /**
      * @brief Constructs a dock widget from its serialized form.
@@ -64,6 +64,13 @@ DockWidgetQuick::~DockWidgetQuick()
 
 void DockWidgetQuick::setWidget(const QString &qmlFilename)
 {
+    if (Config::self().asynchronousGuestCreation()) {
+        createItemAsync(d->m_qmlEngine, qmlFilename, this, [this](QQuickItem *guest) {
+            setWidget(guest);
+        });
+        return;
+    }
+
     QQuickItem *guest = createItem(d->m_qmlEngine, qmlFilename);
     if (!guest)
         return;
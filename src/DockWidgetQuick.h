@@ -61,6 +61,7 @@ public:
 
     /// Sets the DockWidget's guest item
     /// Similar to DockWidgetBase::setWidget(QQuickItem*)
+    /// If Config::asynchronousGuestCreation() is true the guest is only set once it's ready.
     void setWidget(const QString &qmlFilename);
 
     /// @reimp
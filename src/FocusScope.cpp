@@ -37,10 +37,8 @@ public:
         : q(qq)
         , m_thisWidget(thisWidget)
     {
-        connect(qApp, &QGuiApplication::focusObjectChanged,
-                this, &Private::onFocusObjectChanged);
-
-        onFocusObjectChanged(qApp->focusObject());
+        QObject *focusObject = qApp->focusObject();
+        onFocusObjectChanged(focusObject, isInFocusScope(qobject_cast<WidgetType *>(focusObject)));
         m_inCtor = false;
     }
 
@@ -63,7 +61,7 @@ public:
     ~Private() override;
 
     void setIsFocused(bool);
-    void onFocusObjectChanged(QObject *);
+    void onFocusObjectChanged(QObject *, bool isInScope);
     bool isInFocusScope(WidgetType *) const;
 
     FocusScope *const q;
@@ -80,10 +78,12 @@ FocusScope::Private::~Private()
 FocusScope::FocusScope(QWidgetAdapter *thisWidget)
     : d(new Private(this, thisWidget))
 {
+    DockRegistry::self()->registerFocusScope(this);
 }
 
 FocusScope::~FocusScope()
 {
+    DockRegistry::self()->unregisterFocusScope(this);
     delete d;
 }
 
@@ -129,7 +129,22 @@ void FocusScope::Private::setIsFocused(bool is)
     }
 }
 
-void FocusScope::Private::onFocusObjectChanged(QObject *obj)
+WidgetType *FocusScope::scopeWidget() const
+{
+    return d->m_thisWidget;
+}
+
+bool FocusScope::isInFocusScope(WidgetType *widget) const
+{
+    return d->isInFocusScope(widget);
+}
+
+void FocusScope::onFocusObjectChanged(QObject *focusObject, bool isInScope)
+{
+    d->onFocusObjectChanged(focusObject, isInScope);
+}
+
+void FocusScope::Private::onFocusObjectChanged(QObject *obj, bool isInScope)
 {
     auto widget = qobject_cast<WidgetType *>(obj);
     if (!widget) {
@@ -137,13 +152,12 @@ void FocusScope::Private::onFocusObjectChanged(QObject *obj)
         return;
     }
 
-    const bool is = isInFocusScope(widget);
-    if (is && m_lastFocusedInScope != widget && !qobject_cast<TitleBar *>(obj)) {
+    if (isInScope && m_lastFocusedInScope != widget && !qobject_cast<TitleBar *>(obj)) {
         m_lastFocusedInScope = widget;
-        setIsFocused(is);
+        setIsFocused(isInScope);
         /* Q_EMIT */ q->focusedWidgetChangedCallback();
     } else {
-        setIsFocused(is);
+        setIsFocused(isInScope);
     }
 }
 
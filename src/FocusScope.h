@@ -54,6 +54,12 @@ protected:
     virtual void focusedWidgetChangedCallback() = 0;
 
 private:
+    friend class DockRegistry;
+    // For DockRegistry, which tracks focus changes for all scopes at once
+    WidgetType *scopeWidget() const;
+    bool isInFocusScope(WidgetType *) const;
+    void onFocusObjectChanged(QObject *focusObject, bool isInScope);
+
     class Private;
     Private *const d;
 };
@@ -42,6 +42,7 @@
 #include "private/quick/FloatingWindowQuick_p.h"
 #include "private/quick/RubberBandQuick.h"
 #include "private/multisplitter/Separator_quick.h"
+#include "private/multisplitter/SeparatorBatch_quick.h"
 #endif
 
 // clazy:excludeall=ctor-missing-parent-argument
@@ -54,9 +55,16 @@ FrameworkWidgetFactory::~FrameworkWidgetFactory()
 {
 }
 
+void FrameworkWidgetFactory::resetFrame(Frame *) const
+{
+}
+
 #ifdef KDDOCKWIDGETS_QTWIDGETS
 Frame *DefaultWidgetFactory::createFrame(QWidgetOrQuick *parent, FrameOptions options) const
 {
+    if (Frame *frame = Frame::takeRecycledFrame(parent, options))
+        return frame;
+
     return new FrameWidget(parent, options);
 }
 
@@ -93,6 +101,9 @@ FloatingWindow *DefaultWidgetFactory::createFloatingWindow(MainWindowBase *paren
 
 FloatingWindow *DefaultWidgetFactory::createFloatingWindow(Frame *frame, MainWindowBase *parent, QRect suggestedGeometry) const
 {
+    if (FloatingWindow *window = FloatingWindow::takePooledWindow(frame, suggestedGeometry, parent))
+        return window;
+
     return new FloatingWindowWidget(frame, suggestedGeometry, parent);
 }
 
@@ -142,6 +153,9 @@ QAbstractButton *DefaultWidgetFactory::createTitleBarButton(QWidget *parent, Tit
 
 Frame *DefaultWidgetFactory::createFrame(QWidgetOrQuick *parent, FrameOptions options) const
 {
+    if (Frame *frame = Frame::takeRecycledFrame(parent, options))
+        return frame;
+
     return new FrameQuick(parent, options);
 }
 
@@ -167,6 +181,9 @@ FloatingWindow *DefaultWidgetFactory::createFloatingWindow(MainWindowBase *paren
 
 FloatingWindow *DefaultWidgetFactory::createFloatingWindow(Frame *frame, MainWindowBase *parent, QRect suggestedGeometry) const
 {
+    if (FloatingWindow *window = FloatingWindow::takePooledWindow(frame, suggestedGeometry, parent))
+        return window;
+
     return new FloatingWindowQuick(frame, suggestedGeometry, parent);
 }
 
@@ -197,6 +214,9 @@ TabWidget *DefaultWidgetFactory::createTabWidget(Frame *parent, TabWidgetOptions
 
 Layouting::Separator *DefaultWidgetFactory::createSeparator(Layouting::Widget *parent) const
 {
+    if (Config::self().batchedSeparators())
+        return new Layouting::BatchedSeparatorQuick(parent);
+
     return new Layouting::SeparatorQuick(parent);
 }
 
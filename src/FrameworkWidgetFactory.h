@@ -86,6 +86,13 @@ public:
     ///@param options just forward to Frame's constructor
     virtual Frame *createFrame(QWidgetOrQuick *parent = nullptr, FrameOptions options = FrameOption_None) const = 0;
 
+    ///@brief Called internally by the framework when an empty Frame is put into the recycling pool
+    ///       Override to reset any state your Frame sub-class keeps, so it can be reused by a later
+    ///       createFrame(). Your createFrame() should try Frame::takeRecycledFrame() before creating a new one.
+    ///       Only called when Config::setFramePoolSize() is used.
+    ///@param frame The frame being recycled. It's already hidden and has no parent nor dock widgets.
+    virtual void resetFrame(Frame *frame) const;
+
     ///@brief Called internally by the framework to create a TitleBar
     ///       Override to provide your own TitleBar sub-class. If overridden then
     ///       you also need to override the overload below.
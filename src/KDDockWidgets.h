@@ -305,6 +305,45 @@ enum class FloatingWindowFlag {
 };
 Q_DECLARE_FLAGS(FloatingWindowFlags, FloatingWindowFlag)
 
+///@brief Describes the different phases of a drag which are timed when drag statistics are enabled
+///@sa Config::setDragStatisticsEnabled()
+enum class DragPhase {
+    PreDrag = 0, ///< Mouse moves before the drag threshold is reached
+    Dragging, ///< Mouse moves while dragging a floating window around
+    InternalMDIDragging, ///< Mouse moves while dragging a dock widget inside a MDI area
+    DropAreaHover, ///< Hovering a drop area, which includes resolving the hovered frame
+    IndicatorsHover, ///< Updating the drop indicators under the mouse
+    Drop, ///< Dropping into a drop area
+    Count ///< Number of phases, not a phase
+};
+Q_ENUM_NS(DragPhase)
+
+///@brief Timing summary of a single DragPhase. Durations are in nanoseconds.
+struct DragPhaseStatistics
+{
+    int count = 0; ///< How many times the phase ran during the drag
+    qint64 p50 = 0; ///< Median duration
+    qint64 p95 = 0; ///< 95th percentile duration
+    qint64 max = 0; ///< Longest duration
+    qint64 total = 0; ///< Sum of all durations
+};
+
+///@brief Statistics about a single drag, from mouse press until drop or cancel
+///@sa Config::setDragStatisticsEnabled()
+struct DragStatistics
+{
+    DragPhaseStatistics phase(DragPhase p) const
+    {
+        return phases[int(p)];
+    }
+
+    DragPhaseStatistics phases[int(DragPhase::Count)];
+    int numMouseMoves = 0; ///< Number of mouse move events received, including coalesced ones
+    int numSuggestedDropRectCalls = 0; ///< Number of times the layout was asked for a drop rect
+    qint64 durationMs = 0; ///< Wall time of the whole drag
+    bool dropped = false; ///< Whether the drag ended with a drop, instead of being canceled
+};
+
 ///@internal
 inline QString locationStr(Location loc)
 {
@@ -336,5 +375,6 @@ QT_END_NAMESPACE
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(KDDockWidgets::FrameOptions)
 Q_DECLARE_METATYPE(KDDockWidgets::InitialVisibilityOption)
+Q_DECLARE_METATYPE(KDDockWidgets::DragStatistics)
 
 #endif
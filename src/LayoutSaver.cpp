@@ -146,50 +146,9 @@ bool LayoutSaver::restoreFromFile(const QString &jsonFilename)
 
 QByteArray LayoutSaver::serializeLayout() const
 {
-    if (!d->m_dockRegistry->isSane()) {
-        qWarning() << Q_FUNC_INFO << "Refusing to serialize this layout. Check previous warnings.";
-        return {};
-    }
-
     LayoutSaver::Layout layout;
-
-    // Just a simplification. One less type of windows to handle.
-    d->m_dockRegistry->ensureAllFloatingWidgetsAreMorphed();
-
-    const MainWindowBase::List mainWindows = d->m_dockRegistry->mainwindows();
-    layout.mainWindows.reserve(mainWindows.size());
-    for (MainWindowBase *mainWindow : mainWindows) {
-        if (d->matchesAffinity(mainWindow->affinities()))
-            layout.mainWindows.push_back(mainWindow->serialize());
-    }
-
-    const QVector<KDDockWidgets::FloatingWindow *> floatingWindows = d->m_dockRegistry->floatingWindows();
-    layout.floatingWindows.reserve(floatingWindows.size());
-    for (KDDockWidgets::FloatingWindow *floatingWindow : floatingWindows) {
-        if (d->matchesAffinity(floatingWindow->affinities()))
-            layout.floatingWindows.push_back(floatingWindow->serialize());
-    }
-
-    // Closed dock widgets also have interesting things to save, like geometry and placeholder info
-    const DockWidgetBase::List closedDockWidgets = d->m_dockRegistry->closedDockwidgets();
-    layout.closedDockWidgets.reserve(closedDockWidgets.size());
-    for (DockWidgetBase *dockWidget : closedDockWidgets) {
-        if (d->matchesAffinity(dockWidget->affinities()))
-            layout.closedDockWidgets.push_back(dockWidget->d->serialize());
-    }
-
-    // Save the placeholder info. We do it last, as we also restore it last, since we need all items to be created
-    // before restoring the placeholders
-
-    const DockWidgetBase::List dockWidgets = d->m_dockRegistry->dockwidgets();
-    layout.allDockWidgets.reserve(dockWidgets.size());
-    for (DockWidgetBase *dockWidget : dockWidgets) {
-        if (d->matchesAffinity(dockWidget->affinities())) {
-            auto dw = dockWidget->d->serialize();
-            dw->lastPosition = dockWidget->d->lastPosition()->serialize();
-            layout.allDockWidgets.push_back(dw);
-        }
-    }
+    if (!d->serialize(layout))
+        return {};
 
     return layout.toJson();
 }
@@ -222,90 +181,7 @@ bool LayoutSaver::restoreLayout(const QByteArray &data)
         return false;
     }
 
-    if (!layout.isValid()) {
-        return false;
-    }
-
-    layout.scaleSizes(d->m_restoreOptions);
-
-    d->floatWidgetsWhichSkipRestore(layout.mainWindowNames());
-    d->floatUnknownWidgets(layout);
-
-    Private::RAIIIsRestoring isRestoring;
-
-    // Hide all dockwidgets and unparent them from any layout before starting restore
-    // We only close the stuff that the loaded JSON knows about. Unknown widgets might be newer.
-
-    d->m_dockRegistry->clear(d->m_dockRegistry->dockWidgets(layout.dockWidgetsToClose()),
-                             d->m_dockRegistry->mainWindows(layout.mainWindowNames()),
-                             d->m_affinityNames);
-
-    // 1. Restore main windows
-    for (const LayoutSaver::MainWindow &mw : qAsConst(layout.mainWindows)) {
-        MainWindowBase *mainWindow = d->m_dockRegistry->mainWindowByName(mw.uniqueName);
-        if (!mainWindow) {
-            if (auto mwFunc = Config::self().mainWindowFactoryFunc()) {
-                mainWindow = mwFunc(mw.uniqueName);
-            } else {
-                qWarning() << "Failed to restore layout create MainWindow with name" << mw.uniqueName << "first";
-                return false;
-            }
-        }
-
-        if (!d->matchesAffinity(mainWindow->affinities()))
-            continue;
-
-        if (!(d->m_restoreOptions & InternalRestoreOption::SkipMainWindowGeometry)) {
-            d->deserializeWindowGeometry(mw, mainWindow->window()); // window(), as the MainWindow can be embedded
-            if (mw.windowState != Qt::WindowNoState) {
-                if (auto w = mainWindow->windowHandle()) {
-                    w->setWindowState(mw.windowState);
-                }
-            }
-        }
-
-        if (!mainWindow->deserialize(mw))
-            return false;
-    }
-
-    // 2. Restore FloatingWindows
-    for (LayoutSaver::FloatingWindow &fw : layout.floatingWindows) {
-        if (!d->matchesAffinity(fw.affinities) || fw.skipsRestore())
-            continue;
-
-        MainWindowBase *parent = fw.parentIndex == -1 ? nullptr
-                                                      : DockRegistry::self()->mainwindows().at(fw.parentIndex);
-
-        auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(parent, static_cast<FloatingWindowFlags>(fw.flags));
-        fw.floatingWindowInstance = floatingWindow;
-        d->deserializeWindowGeometry(fw, floatingWindow);
-        if (!floatingWindow->deserialize(fw)) {
-            qWarning() << Q_FUNC_INFO << "Failed to deserialize floating window";
-            return false;
-        }
-    }
-
-    // 3. Restore closed dock widgets. They remain closed but acquire geometry and placeholder properties
-    for (const auto &dw : qAsConst(layout.closedDockWidgets)) {
-        if (d->matchesAffinity(dw->affinities)) {
-            DockWidgetBase::deserialize(dw);
-        }
-    }
-
-    // 4. Restore the placeholder info, now that the Items have been created
-    for (const auto &dw : qAsConst(layout.allDockWidgets)) {
-        if (!d->matchesAffinity(dw->affinities))
-            continue;
-
-        if (DockWidgetBase *dockWidget =
-                d->m_dockRegistry->dockByName(dw->uniqueName, DockRegistry::DockByNameFlag::ConsultRemapping)) {
-            dockWidget->d->lastPosition()->deserialize(dw->lastPosition);
-        } else {
-            qWarning() << Q_FUNC_INFO << "Couldn't find dock widget" << dw->uniqueName;
-        }
-    }
-
-    return true;
+    return d->restore(layout);
 }
 
 void LayoutSaver::setAffinityNames(const QStringList &affinityNames)
@@ -379,6 +255,175 @@ bool LayoutSaver::Private::matchesAffinity(const QStringList &affinities) const
         || DockRegistry::self()->affinitiesMatch(m_affinityNames, affinities);
 }
 
+bool LayoutSaver::Private::serialize(LayoutSaver::Layout &layout)
+{
+    if (!m_dockRegistry->isSane()) {
+        qWarning() << Q_FUNC_INFO << "Refusing to serialize this layout. Check previous warnings.";
+        return false;
+    }
+
+    // Just a simplification. One less type of windows to handle.
+    m_dockRegistry->ensureAllFloatingWidgetsAreMorphed();
+
+    const MainWindowBase::List mainWindows = m_dockRegistry->mainwindows();
+    layout.mainWindows.reserve(mainWindows.size());
+    for (MainWindowBase *mainWindow : mainWindows) {
+        if (matchesAffinity(mainWindow->affinities()))
+            layout.mainWindows.push_back(mainWindow->serialize());
+    }
+
+    const QVector<KDDockWidgets::FloatingWindow *> floatingWindows = m_dockRegistry->floatingWindows();
+    layout.floatingWindows.reserve(floatingWindows.size());
+    for (KDDockWidgets::FloatingWindow *floatingWindow : floatingWindows) {
+        if (matchesAffinity(floatingWindow->affinities()))
+            layout.floatingWindows.push_back(floatingWindow->serialize());
+    }
+
+    // Closed dock widgets also have interesting things to save, like geometry and placeholder info
+    const DockWidgetBase::List closedDockWidgets = m_dockRegistry->closedDockwidgets();
+    layout.closedDockWidgets.reserve(closedDockWidgets.size());
+    for (DockWidgetBase *dockWidget : closedDockWidgets) {
+        if (matchesAffinity(dockWidget->affinities()))
+            layout.closedDockWidgets.push_back(dockWidget->d->serialize());
+    }
+
+    // Save the placeholder info. We do it last, as we also restore it last, since we need all items to be created
+    // before restoring the placeholders
+
+    const DockWidgetBase::List dockWidgets = m_dockRegistry->dockwidgets();
+    layout.allDockWidgets.reserve(dockWidgets.size());
+    for (DockWidgetBase *dockWidget : dockWidgets) {
+        if (matchesAffinity(dockWidget->affinities())) {
+            auto dw = dockWidget->d->serialize();
+            dw->lastPosition = dockWidget->d->lastPosition()->serialize();
+            layout.allDockWidgets.push_back(dw);
+        }
+    }
+
+    return true;
+}
+
+bool LayoutSaver::Private::restore(LayoutSaver::Layout &layout, const Scope *scope)
+{
+    if (!layout.isValid()) {
+        return false;
+    }
+
+    layout.scaleSizes(m_restoreOptions);
+
+    // The indexes in scope->keptFloatingWindows refer to this list
+    const QVector<KDDockWidgets::FloatingWindow *> currentFloatingWindows = m_dockRegistry->floatingWindows();
+    const QStringList mainWindowNames = scope ? scope->mainWindows : layout.mainWindowNames();
+
+    floatWidgetsWhichSkipRestore(mainWindowNames);
+    floatUnknownWidgets(layout, mainWindowNames);
+
+    Private::RAIIIsRestoring isRestoring;
+
+    // Hide all dockwidgets and unparent them from any layout before starting restore
+    // We only close the stuff that the loaded layout knows about. Unknown widgets might be newer.
+
+    m_dockRegistry->clear(m_dockRegistry->dockWidgets(scope ? scope->dockWidgets : layout.dockWidgetsToClose()),
+                          m_dockRegistry->mainWindows(mainWindowNames),
+                          m_affinityNames);
+
+    // 1. Restore main windows
+    for (const LayoutSaver::MainWindow &mw : qAsConst(layout.mainWindows)) {
+        if (scope && !scope->mainWindows.contains(mw.uniqueName))
+            continue;
+
+        MainWindowBase *mainWindow = m_dockRegistry->mainWindowByName(mw.uniqueName);
+        if (!mainWindow) {
+            if (auto mwFunc = Config::self().mainWindowFactoryFunc()) {
+                mainWindow = mwFunc(mw.uniqueName);
+            } else {
+                qWarning() << "Failed to restore layout create MainWindow with name" << mw.uniqueName << "first";
+                return false;
+            }
+        }
+
+        if (!matchesAffinity(mainWindow->affinities()))
+            continue;
+
+        if (!(m_restoreOptions & InternalRestoreOption::SkipMainWindowGeometry)) {
+            deserializeWindowGeometry(mw, mainWindow->window()); // window(), as the MainWindow can be embedded
+            if (mw.windowState != Qt::WindowNoState) {
+                if (auto w = mainWindow->windowHandle()) {
+                    w->setWindowState(mw.windowState);
+                }
+            }
+        }
+
+        if (!mainWindow->deserialize(mw))
+            return false;
+    }
+
+    // 2. Restore FloatingWindows
+    for (int i = 0; i < layout.floatingWindows.size(); ++i) {
+        LayoutSaver::FloatingWindow &fw = layout.floatingWindows[i];
+        if (!matchesAffinity(fw.affinities) || fw.skipsRestore())
+            continue;
+
+        const int currentIndex = scope ? scope->keptFloatingWindows.value(i, -1) : -1;
+        if (currentIndex != -1) {
+            // Its contents didn't change, the placeholders below can refer to it as it is
+            fw.floatingWindowInstance = currentFloatingWindows.at(currentIndex);
+            if (scope->movedFloatingWindows.contains(i))
+                deserializeWindowGeometry(fw, fw.floatingWindowInstance);
+            continue;
+        }
+
+        MainWindowBase *parent = fw.parentIndex == -1 ? nullptr
+                                                      : DockRegistry::self()->mainwindows().at(fw.parentIndex);
+
+        auto floatingWindow = Config::self().frameworkWidgetFactory()->createFloatingWindow(parent, static_cast<FloatingWindowFlags>(fw.flags));
+        fw.floatingWindowInstance = floatingWindow;
+        deserializeWindowGeometry(fw, floatingWindow);
+        if (!floatingWindow->deserialize(fw)) {
+            qWarning() << Q_FUNC_INFO << "Failed to deserialize floating window";
+            return false;
+        }
+    }
+
+    // 3. Restore closed dock widgets. They remain closed but acquire geometry and placeholder properties
+    for (const auto &dw : qAsConst(layout.closedDockWidgets)) {
+        if (scope && !scope->dockWidgets.contains(dw->uniqueName))
+            continue;
+
+        if (matchesAffinity(dw->affinities)) {
+            DockWidgetBase::deserialize(dw);
+        }
+    }
+
+    // 4. Restore the placeholder info, now that the Items have been created
+    for (const auto &dw : qAsConst(layout.allDockWidgets)) {
+        if (!matchesAffinity(dw->affinities))
+            continue;
+
+        if (scope && !scope->dockWidgets.contains(dw->uniqueName) && !scope->lastPositions.contains(dw->uniqueName)) {
+            // Untouched, unless it refers to an item which was just rebuilt
+            const bool refersToRestoredItem = std::any_of(dw->lastPosition.placeholders.cbegin(), dw->lastPosition.placeholders.cend(), [scope](const LayoutSaver::Placeholder &placeholder) {
+                return placeholder.isFloatingWindow ? !scope->keptFloatingWindows.contains(placeholder.indexOfFloatingWindow)
+                                                    : scope->mainWindows.contains(placeholder.mainWindowUniqueName);
+            });
+
+            if (!refersToRestoredItem)
+                continue;
+        }
+
+        if (DockWidgetBase *dockWidget =
+                m_dockRegistry->dockByName(dw->uniqueName, DockRegistry::DockByNameFlag::ConsultRemapping)) {
+            if (scope)
+                dockWidget->d->lastPosition()->removePlaceholders();
+            dockWidget->d->lastPosition()->deserialize(dw->lastPosition);
+        } else {
+            qWarning() << Q_FUNC_INFO << "Couldn't find dock widget" << dw->uniqueName;
+        }
+    }
+
+    return true;
+}
+
 void LayoutSaver::Private::floatWidgetsWhichSkipRestore(const QStringList &mainWindowNames)
 {
     // Widgets with the DockWidget::LayoutSaverOption::Skip flag skip restore completely.
@@ -396,13 +441,13 @@ void LayoutSaver::Private::floatWidgetsWhichSkipRestore(const QStringList &mainW
     }
 }
 
-void LayoutSaver::Private::floatUnknownWidgets(const LayoutSaver::Layout &layout)
+void LayoutSaver::Private::floatUnknownWidgets(const LayoutSaver::Layout &layout, const QStringList &mainWindowNames)
 {
     // An old *.json layout file might have not know about existing dock widgets
     // When restoring such a file, we need to float any visible dock widgets which it doesn't know about
     // so we can restore the MainWindow layout properly
 
-    for (MainWindowBase *mw : DockRegistry::self()->mainWindows(layout.mainWindowNames())) {
+    for (MainWindowBase *mw : DockRegistry::self()->mainWindows(mainWindowNames)) {
         const KDDockWidgets::DockWidgetBase::List docks = mw->layoutWidget()->dockWidgets();
         for (DockWidgetBase *dw : docks) {
             if (!layout.containsDockWidget(dw->uniqueName())) {
@@ -0,0 +1,70 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "LayoutSnapshot.h"
+
+#include <atomic>
+
+using namespace KDDockWidgets;
+
+// Readers never block the GUI thread, they just take a reference to whatever snapshot is current.
+// Old snapshots are freed once their last reader releases them.
+static std::shared_ptr<const LayoutSnapshot> s_current;
+static std::atomic<quint64> s_version(0);
+
+LayoutSnapshot::Ptr LayoutSnapshot::current()
+{
+    return std::atomic_load_explicit(&s_current, std::memory_order_acquire);
+}
+
+quint64 LayoutSnapshot::currentVersion()
+{
+    return s_version.load(std::memory_order_acquire);
+}
+
+quint64 LayoutSnapshot::version() const
+{
+    return m_version;
+}
+
+const QVector<LayoutSnapshot::FrameInfo> &LayoutSnapshot::frames() const
+{
+    return m_frames;
+}
+
+const QVector<LayoutSnapshot::DockWidgetInfo> &LayoutSnapshot::dockWidgets() const
+{
+    return m_dockWidgets;
+}
+
+const LayoutSnapshot::DockWidgetInfo *LayoutSnapshot::dockWidget(const QString &uniqueName) const
+{
+    for (const DockWidgetInfo &info : m_dockWidgets) {
+        if (info.uniqueName == uniqueName)
+            return &info;
+    }
+
+    return nullptr;
+}
+
+void LayoutSnapshot::publish(std::shared_ptr<LayoutSnapshot> snapshot)
+{
+    // Only called from the GUI thread, so there's a single writer
+    const bool isNull = !snapshot;
+    if (!isNull)
+        snapshot->m_version = s_version.load(std::memory_order_relaxed) + 1;
+
+    std::atomic_store_explicit(&s_current, std::shared_ptr<const LayoutSnapshot>(std::move(snapshot)),
+                               std::memory_order_release);
+
+    if (!isNull)
+        s_version.fetch_add(1, std::memory_order_release);
+}
@@ -0,0 +1,111 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_LAYOUTSNAPSHOT_H
+#define KD_LAYOUTSNAPSHOT_H
+
+/**
+ * @file
+ * @brief An immutable view of the layout which can be read from any thread.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#include "docks_export.h"
+
+#include <QRect>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+
+class TestDocks;
+
+namespace KDDockWidgets {
+
+class DockRegistry;
+
+/**
+ * @brief LayoutSnapshot is a read-only copy of which dock widgets exist, where they are and
+ * whether they're visible.
+ *
+ * The GUI classes can only be used from the GUI thread. A LayoutSnapshot however only holds
+ * plain values and is never modified once published, so it can be read from any thread, without
+ * marshalling to the GUI thread.
+ *
+ * Publishing is opt-in, see Config::setLayoutSnapshotsEnabled(). A new snapshot is then published,
+ * at most once per event loop iteration, whenever dock widgets or frames are added, removed, moved,
+ * resized, shown, hidden or change their current tab.
+ *
+ * Example, from a worker thread:
+ *     if (LayoutSnapshot::Ptr snapshot = LayoutSnapshot::current()) {
+ *         for (const LayoutSnapshot::DockWidgetInfo &dock : snapshot->dockWidgets())
+ *             qDebug() << dock.uniqueName << dock.globalGeometry << dock.isVisible;
+ *     }
+ */
+class DOCKS_EXPORT LayoutSnapshot
+{
+public:
+    typedef std::shared_ptr<const LayoutSnapshot> Ptr;
+
+    struct FrameInfo
+    {
+        QStringList dockWidgets; ///< unique names of the dock widgets, in tab order
+        int currentIndex = -1;
+        QRect globalGeometry;
+        bool isVisible = false;
+        bool isFloating = false;
+        QString mainWindow; ///< unique name of the main window, empty if not in one
+    };
+
+    struct DockWidgetInfo
+    {
+        QString uniqueName;
+        int frameIndex = -1; ///< index into frames(), -1 if it's not in a frame (closed, for example)
+        QRect globalGeometry;
+        bool isOpen = false;
+        bool isVisible = false;
+        bool isCurrentTab = false;
+        bool isFloating = false;
+    };
+
+    ///@brief Returns the latest published snapshot. Thread-safe.
+    /// nullptr if snapshots aren't enabled, see Config::setLayoutSnapshotsEnabled()
+    static Ptr current();
+
+    ///@brief Returns the version of the latest published snapshot. Thread-safe.
+    /// Cheaper than current() when a reader just wants to know if something changed.
+    static quint64 currentVersion();
+
+    ///@brief Increases each time a snapshot is published. Starts at 1.
+    quint64 version() const;
+
+    const QVector<FrameInfo> &frames() const;
+    const QVector<DockWidgetInfo> &dockWidgets() const;
+
+    ///@brief Returns the dock widget named @p uniqueName, or nullptr if there's none
+    const DockWidgetInfo *dockWidget(const QString &uniqueName) const;
+
+private:
+    friend class DockRegistry;
+    friend class ::TestDocks;
+    LayoutSnapshot() = default;
+    static void publish(std::shared_ptr<LayoutSnapshot>);
+
+    quint64 m_version = 0;
+    QVector<FrameInfo> m_frames;
+    QVector<DockWidgetInfo> m_dockWidgets;
+};
+
+}
+
+#endif
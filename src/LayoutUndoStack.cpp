@@ -0,0 +1,549 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "LayoutUndoStack.h"
+#include "Config.h"
+#include "LayoutSaver.h"
+#include "private/LayoutSaver_p.h"
+
+#include <QDebug>
+#include <QScopedValueRollback>
+#include <QSet>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+
+using namespace KDDockWidgets;
+
+/// Returns the names of the dock widgets in a serialized main window or floating window
+static QStringList dockWidgetsInWindow(const QVariantMap &window)
+{
+    QStringList names;
+    const QVariantMap frames = window.value(QStringLiteral("multiSplitterLayout")).toMap().value(QStringLiteral("frames")).toMap();
+    for (const QVariant &frame : frames)
+        names += frame.toMap().value(QStringLiteral("dockWidgets")).toStringList();
+
+    for (auto it = window.cbegin(), end = window.cend(); it != end; ++it) {
+        if (it.key().startsWith(QLatin1String("sidebar-")))
+            names += it.value().toStringList();
+    }
+
+    return names;
+}
+
+/// Floating windows don't have a name, but their dock widgets do
+static QString floatingWindowKey(const QVariantMap &floatingWindow)
+{
+    QStringList names = dockWidgetsInWindow(floatingWindow);
+    names.sort();
+    return names.join(QLatin1Char('\n'));
+}
+
+/**
+ * Returns what identifies an entry of a list in the layout, so it's matched with the same entry in
+ * another step even if it moved in the list. Returns an empty string if the entry has no identity.
+ */
+static QString entryKey(const QVariant &entry)
+{
+    if (entry.userType() != QMetaType::QVariantMap)
+        return {};
+
+    const QVariantMap map = entry.toMap();
+    auto it = map.constFind(QStringLiteral("uniqueName")); // Main windows and dock widgets
+    if (it != map.cend())
+        return it.value().toString();
+
+    it = map.constFind(QStringLiteral("guestId")); // Layout items showing a frame
+    if (it != map.cend())
+        return it.value().toString();
+
+    if (map.contains(QStringLiteral("multiSplitterLayout")))
+        return floatingWindowKey(map);
+
+    return {};
+}
+
+static QVariantMap withStableGuestIds(QVariantMap item, const QHash<QString, QString> &stableIds)
+{
+    auto it = item.find(QStringLiteral("guestId"));
+    if (it != item.end())
+        it.value() = stableIds.value(it.value().toString());
+
+    it = item.find(QStringLiteral("children"));
+    if (it != item.end()) {
+        QVariantList children = it.value().toList();
+        for (QVariant &child : children)
+            child = withStableGuestIds(child.toMap(), stableIds);
+        it.value() = children;
+    }
+
+    return item;
+}
+
+/**
+ * Returns @p window with its frame ids replaced by the name of the frame's first dock widget.
+ * Restoring creates new frames, with new ids, which would otherwise make an unchanged window look different.
+ */
+static QVariantMap withStableFrameIds(QVariantMap window)
+{
+    QVariantMap multiSplitter = window.value(QStringLiteral("multiSplitterLayout")).toMap();
+    const QVariantMap frames = multiSplitter.value(QStringLiteral("frames")).toMap();
+
+    QHash<QString, QString> stableIds;
+    QVariantMap stableFrames;
+    for (const QVariant &frameV : frames) {
+        QVariantMap frame = frameV.toMap();
+        // A dock widget is only in one frame. The persistent central frame is the only one which can be empty.
+        const QString stableId = frame.value(QStringLiteral("dockWidgets")).toStringList().value(0);
+        stableIds.insert(frame.value(QStringLiteral("id")).toString(), stableId);
+        frame.insert(QStringLiteral("id"), stableId);
+        stableFrames.insert(stableId, frame);
+    }
+
+    multiSplitter.insert(QStringLiteral("frames"), stableFrames);
+    multiSplitter.insert(QStringLiteral("layout"), withStableGuestIds(multiSplitter.value(QStringLiteral("layout")).toMap(), stableIds));
+    window.insert(QStringLiteral("multiSplitterLayout"), multiSplitter);
+
+    return window;
+}
+
+/// Returns @p window without its position and state, only what it contains
+static QVariantMap windowContents(QVariantMap window)
+{
+    for (const QString &key : { QStringLiteral("geometry"), QStringLiteral("normalGeometry"), QStringLiteral("screenIndex"),
+                                QStringLiteral("screenSize"), QStringLiteral("isVisible"), QStringLiteral("windowState") })
+        window.remove(key);
+
+    return window;
+}
+
+/**
+ * Compares the layout being applied, @p target, with the @p current one. Returns what needs to be restored
+ * for the current layout to become the target, windows and dock widgets which are the same in both are kept.
+ */
+static LayoutSaver::Private::Scope changedScope(const QVariantMap &current, const QVariantMap &target)
+{
+    LayoutSaver::Private::Scope scope;
+    QSet<QString> dockWidgets;
+    auto addDockWidgets = [&dockWidgets](const QVariantMap &window) {
+        const QStringList names = dockWidgetsInWindow(window);
+        for (const QString &name : names)
+            dockWidgets.insert(name);
+    };
+
+    // 1. Main windows, which don't move when undoing
+    QHash<QString, QVariantMap> currentMainWindows;
+    const QVariantList currentMainWindowsV = current.value(QStringLiteral("mainWindows")).toList();
+    for (const QVariant &mainWindowV : currentMainWindowsV) {
+        const QVariantMap mainWindow = mainWindowV.toMap();
+        currentMainWindows.insert(mainWindow.value(QStringLiteral("uniqueName")).toString(), mainWindow);
+    }
+
+    const QVariantList targetMainWindowsV = target.value(QStringLiteral("mainWindows")).toList();
+    for (const QVariant &mainWindowV : targetMainWindowsV) {
+        const QVariantMap mainWindow = mainWindowV.toMap();
+        const QString name = mainWindow.value(QStringLiteral("uniqueName")).toString();
+        const QVariantMap currentMainWindow = currentMainWindows.value(name);
+        if (windowContents(withStableFrameIds(mainWindow)) != windowContents(withStableFrameIds(currentMainWindow))) {
+            scope.mainWindows.push_back(name);
+            addDockWidgets(mainWindow);
+            addDockWidgets(currentMainWindow);
+        }
+    }
+
+    // 2. Floating windows, kept if they still have the same contents
+    const QVariantList currentFloatingWindows = current.value(QStringLiteral("floatingWindows")).toList();
+    QHash<QString, int> currentFloatingWindowIndexes;
+    for (int i = 0; i < currentFloatingWindows.size(); ++i)
+        currentFloatingWindowIndexes.insert(floatingWindowKey(currentFloatingWindows.at(i).toMap()), i);
+
+    QSet<int> keptCurrentFloatingWindows;
+    const QVariantList targetFloatingWindows = target.value(QStringLiteral("floatingWindows")).toList();
+    for (int i = 0; i < targetFloatingWindows.size(); ++i) {
+        const QVariantMap floatingWindow = targetFloatingWindows.at(i).toMap();
+        const int currentIndex = currentFloatingWindowIndexes.value(floatingWindowKey(floatingWindow), -1);
+        if (currentIndex != -1) {
+            const QVariantMap stableFloatingWindow = withStableFrameIds(floatingWindow);
+            const QVariantMap stableCurrentFloatingWindow = withStableFrameIds(currentFloatingWindows.at(currentIndex).toMap());
+            if (windowContents(stableFloatingWindow) == windowContents(stableCurrentFloatingWindow)) {
+                scope.keptFloatingWindows.insert(i, currentIndex);
+                keptCurrentFloatingWindows.insert(currentIndex);
+                if (stableFloatingWindow != stableCurrentFloatingWindow)
+                    scope.movedFloatingWindows.insert(i);
+                continue;
+            }
+        }
+
+        addDockWidgets(floatingWindow);
+    }
+
+    for (int i = 0; i < currentFloatingWindows.size(); ++i) {
+        if (!keptCurrentFloatingWindows.contains(i))
+            addDockWidgets(currentFloatingWindows.at(i).toMap());
+    }
+
+    // 3. Dock widgets which were closed or opened
+    const QStringList currentClosed = current.value(QStringLiteral("closedDockWidgets")).toStringList();
+    const QStringList targetClosed = target.value(QStringLiteral("closedDockWidgets")).toStringList();
+    for (const QString &name : currentClosed) {
+        if (!targetClosed.contains(name))
+            dockWidgets.insert(name);
+    }
+    for (const QString &name : targetClosed) {
+        if (!currentClosed.contains(name))
+            dockWidgets.insert(name);
+    }
+
+    // 4. Dock widgets whose last position changed
+    QHash<QString, QVariant> currentDockWidgets;
+    const QVariantList currentDockWidgetsV = current.value(QStringLiteral("allDockWidgets")).toList();
+    for (const QVariant &dockWidget : currentDockWidgetsV)
+        currentDockWidgets.insert(dockWidget.toMap().value(QStringLiteral("uniqueName")).toString(), dockWidget);
+
+    const QVariantList targetDockWidgetsV = target.value(QStringLiteral("allDockWidgets")).toList();
+    for (const QVariant &dockWidget : targetDockWidgetsV) {
+        const QString name = dockWidget.toMap().value(QStringLiteral("uniqueName")).toString();
+        if (currentDockWidgets.value(name) != dockWidget)
+            scope.lastPositions.push_back(name);
+    }
+
+    // Like LayoutSaver::restoreLayout(), dock widgets which the target doesn't know about are left alone
+    scope.dockWidgets.reserve(dockWidgets.size());
+    for (const QVariant &dockWidget : targetDockWidgetsV) {
+        const QString name = dockWidget.toMap().value(QStringLiteral("uniqueName")).toString();
+        if (dockWidgets.contains(name))
+            scope.dockWidgets.push_back(name);
+    }
+
+    return scope;
+}
+
+/**
+ * Makes @p value share the data of @p previous wherever both are equal, so unchanged subtrees
+ * of the layout are only stored once across steps. List entries are matched by their entryKey(),
+ * the ones without a key by their position.
+ * Returns whether anything differs.
+ */
+static bool shareUnchanged(QVariant &value, const QVariant &previous)
+{
+    if (value.userType() == QMetaType::QVariantMap && previous.userType() == QMetaType::QVariantMap) {
+        QVariantMap map = value.toMap();
+        const QVariantMap previousMap = previous.toMap();
+        bool changed = map.size() != previousMap.size();
+        for (auto it = map.begin(), end = map.end(); it != end; ++it) {
+            auto previousIt = previousMap.constFind(it.key());
+            if (previousIt == previousMap.cend()) {
+                changed = true;
+            } else if (shareUnchanged(it.value(), previousIt.value())) {
+                changed = true;
+            }
+        }
+
+        value = changed ? QVariant(map) : previous;
+        return changed;
+    }
+
+    if (value.userType() == QMetaType::QVariantList && previous.userType() == QMetaType::QVariantList) {
+        QVariantList list = value.toList();
+        const QVariantList previousList = previous.toList();
+
+        QVector<QString> previousKeys;
+        QHash<QString, int> previousIndexes;
+        previousKeys.reserve(previousList.size());
+        for (int i = 0; i < previousList.size(); ++i) {
+            previousKeys.push_back(entryKey(previousList.at(i)));
+            if (!previousKeys.constLast().isEmpty())
+                previousIndexes.insert(previousKeys.constLast(), i);
+        }
+
+        bool changed = list.size() != previousList.size();
+        for (int i = 0; i < list.size(); ++i) {
+            const QString key = entryKey(list.at(i));
+            int previousIndex = -1;
+            if (!key.isEmpty())
+                previousIndex = previousIndexes.value(key, -1);
+            else if (i < previousList.size() && previousKeys.at(i).isEmpty())
+                previousIndex = i;
+
+            if (previousIndex != i)
+                changed = true;
+            if (previousIndex != -1 && shareUnchanged(list[i], previousList.at(previousIndex)))
+                changed = true;
+        }
+
+        value = changed ? QVariant(list) : previous;
+        return changed;
+    }
+
+    if (value == previous) {
+        value = previous;
+        return false;
+    }
+
+    return true;
+}
+
+class LayoutUndoStack::Private
+{
+public:
+    explicit Private(LayoutUndoStack *qq)
+        : q(qq)
+    {
+    }
+
+    QVariant capture();
+    bool apply(const QVariant &state, const QVariant &current);
+    void commit();
+    void push(QVector<QVariant> &stack, const QVariant &state);
+    void emitChanges(bool couldUndo, bool couldRedo);
+
+    static bool isEnabled()
+    {
+        return Config::self().layoutUndoLimit() > 0;
+    }
+
+    LayoutUndoStack *const q;
+    QVector<QVariant> m_undoStack;
+    QVector<QVariant> m_redoStack;
+    QVariant m_before; // The layout remembered by beginOperation()
+    QVariant m_lastCaptured; // Most recent capture, which the next one shares data with
+    bool m_commitScheduled = false;
+    bool m_isApplying = false;
+};
+
+LayoutUndoStack::LayoutUndoStack()
+    : d(new Private(this))
+{
+}
+
+LayoutUndoStack::~LayoutUndoStack()
+{
+    delete d;
+}
+
+LayoutUndoStack *LayoutUndoStack::self()
+{
+    static LayoutUndoStack stack;
+    return &stack;
+}
+
+bool LayoutUndoStack::canUndo() const
+{
+    return !d->m_undoStack.isEmpty();
+}
+
+bool LayoutUndoStack::canRedo() const
+{
+    return !d->m_redoStack.isEmpty();
+}
+
+int LayoutUndoStack::undoCount() const
+{
+    return d->m_undoStack.size();
+}
+
+int LayoutUndoStack::redoCount() const
+{
+    return d->m_redoStack.size();
+}
+
+bool LayoutUndoStack::undo()
+{
+    if (d->m_commitScheduled)
+        d->commit();
+
+    if (d->m_undoStack.isEmpty())
+        return false;
+
+    const bool couldRedo = canRedo();
+    const QVariant current = d->capture();
+    const QVariant state = d->m_undoStack.takeLast();
+    if (current.isValid())
+        d->push(d->m_redoStack, current);
+
+    const bool result = d->apply(state, current);
+    d->emitChanges(true, couldRedo);
+    return result;
+}
+
+bool LayoutUndoStack::redo()
+{
+    if (d->m_commitScheduled)
+        d->commit();
+
+    if (d->m_redoStack.isEmpty())
+        return false;
+
+    const bool couldUndo = canUndo();
+    const QVariant current = d->capture();
+    const QVariant state = d->m_redoStack.takeLast();
+    if (current.isValid())
+        d->push(d->m_undoStack, current);
+
+    const bool result = d->apply(state, current);
+    d->emitChanges(couldUndo, true);
+    return result;
+}
+
+void LayoutUndoStack::clear()
+{
+    const bool couldUndo = canUndo();
+    const bool couldRedo = canRedo();
+    d->m_undoStack.clear();
+    d->m_redoStack.clear();
+    d->m_before.clear();
+    d->m_lastCaptured.clear();
+    d->emitChanges(couldUndo, couldRedo);
+}
+
+void LayoutUndoStack::beginOperation()
+{
+    if (!Private::isEnabled() || d->m_isApplying || LayoutSaver::restoreInProgress())
+        return;
+
+    // The previous operation ended in this same event loop iteration, record it first
+    if (d->m_commitScheduled)
+        d->commit();
+
+    d->m_before = d->capture();
+}
+
+void LayoutUndoStack::endOperation()
+{
+    if (!d->m_before.isValid() || d->m_commitScheduled)
+        return;
+
+    d->m_commitScheduled = true;
+    QTimer::singleShot(0, this, [this] {
+        if (d->m_commitScheduled)
+            d->commit();
+    });
+}
+
+void LayoutUndoStack::cancelOperation()
+{
+    // An ended operation is recorded either way, it might not even be the caller's
+    if (!d->m_commitScheduled)
+        d->m_before.clear();
+}
+
+void LayoutUndoStack::trim()
+{
+    const int limit = Config::self().layoutUndoLimit();
+    if (limit <= 0) {
+        clear();
+        return;
+    }
+
+    const bool couldUndo = canUndo();
+    const bool couldRedo = canRedo();
+    if (d->m_undoStack.size() > limit)
+        d->m_undoStack.erase(d->m_undoStack.begin(), d->m_undoStack.end() - limit);
+    if (d->m_redoStack.size() > limit)
+        d->m_redoStack.erase(d->m_redoStack.begin(), d->m_redoStack.end() - limit);
+    d->emitChanges(couldUndo, couldRedo);
+}
+
+QVariant LayoutUndoStack::Private::capture()
+{
+    // Same as LayoutSaver::serializeLayout(), but without encoding to JSON
+    LayoutSaver saver;
+    LayoutSaver::Layout layout;
+    if (!saver.dptr()->serialize(layout))
+        return {};
+
+    QVariant state = layout.toVariantMap();
+    if (m_lastCaptured.isValid())
+        shareUnchanged(state, m_lastCaptured);
+
+    m_lastCaptured = state;
+    return state;
+}
+
+bool LayoutUndoStack::Private::apply(const QVariant &state, const QVariant &current)
+{
+    QScopedValueRollback<bool> isApplying(m_isApplying, true);
+    m_before.clear();
+
+    // Goes through the same code as LayoutSaver::restoreLayout(), but only for the windows and
+    // dock widgets which differ from the current layout. Main windows aren't moved, only their contents.
+    LayoutSaver saver;
+    LayoutSaver::Private *saverPrivate = saver.dptr();
+    saverPrivate->m_restoreOptions = InternalRestoreOption::SkipMainWindowGeometry;
+    saverPrivate->clearRestoredProperty();
+
+    LayoutSaver::Layout layout;
+    layout.fromVariantMap(state.toMap());
+
+    bool result;
+    if (current.isValid()) {
+        const LayoutSaver::Private::Scope scope = changedScope(current.toMap(), state.toMap());
+        result = saverPrivate->restore(layout, &scope);
+    } else {
+        // The current layout couldn't be serialized, nothing to compare with
+        result = saverPrivate->restore(layout);
+    }
+    saverPrivate->deleteEmptyFrames();
+
+    if (!result)
+        qWarning() << Q_FUNC_INFO << "Failed to apply layout";
+
+    m_lastCaptured = state;
+    return result;
+}
+
+void LayoutUndoStack::Private::commit()
+{
+    m_commitScheduled = false;
+    if (!m_before.isValid())
+        return;
+
+    const QVariant before = m_before;
+    m_before.clear();
+
+    QVariant after = capture();
+    if (!after.isValid() || !shareUnchanged(after, before)) {
+        // Nothing changed, for example a separator was pressed but not moved
+        return;
+    }
+
+    const bool couldUndo = q->canUndo();
+    const bool couldRedo = q->canRedo();
+    m_redoStack.clear();
+    push(m_undoStack, before);
+    emitChanges(couldUndo, couldRedo);
+}
+
+void LayoutUndoStack::Private::push(QVector<QVariant> &stack, const QVariant &state)
+{
+    stack.push_back(state);
+    const int limit = Config::self().layoutUndoLimit();
+    if (stack.size() > limit)
+        stack.erase(stack.begin(), stack.end() - limit);
+}
+
+void LayoutUndoStack::Private::emitChanges(bool couldUndo, bool couldRedo)
+{
+    if (couldUndo != q->canUndo())
+        Q_EMIT q->canUndoChanged(q->canUndo());
+    if (couldRedo != q->canRedo())
+        Q_EMIT q->canRedoChanged(q->canRedo());
+}
+
+LayoutUndoStack::Operation::Operation()
+{
+    LayoutUndoStack::self()->beginOperation();
+}
+
+LayoutUndoStack::Operation::~Operation()
+{
+    LayoutUndoStack::self()->endOperation();
+}
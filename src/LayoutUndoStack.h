@@ -0,0 +1,122 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_LAYOUTUNDOSTACK_H
+#define KD_LAYOUTUNDOSTACK_H
+
+/**
+ * @file
+ * @brief Undo and redo of the user's docking operations.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+#include "docks_export.h"
+
+#include <QObject>
+
+class TestDocks;
+
+namespace KDDockWidgets {
+
+/**
+ * @brief LayoutUndoStack allows to undo and redo docking operations done by the user.
+ *
+ * Dragging and dropping, floating, closing, auto-hiding, re-ordering tabs and moving separators
+ * are recorded. Programmatic changes, like calling DockWidgetBase::setFloating(), aren't, unless
+ * they're wrapped in beginOperation() and endOperation().
+ *
+ * Each step holds the layout the user can return to. Steps share whatever didn't change with the
+ * step before them, so a step only costs memory for what the operation touched.
+ *
+ * Disabled by default, see Config::setLayoutUndoLimit().
+ *
+ * Example:
+ *     auto undoAction = new QAction(tr("Undo layout change"));
+ *     connect(undoAction, &QAction::triggered, LayoutUndoStack::self(), &LayoutUndoStack::undo);
+ *     connect(LayoutUndoStack::self(), &LayoutUndoStack::canUndoChanged, undoAction, &QAction::setEnabled);
+ */
+class DOCKS_EXPORT LayoutUndoStack : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool canUndo READ canUndo NOTIFY canUndoChanged)
+    Q_PROPERTY(bool canRedo READ canRedo NOTIFY canRedoChanged)
+public:
+    ///@brief returns the singleton
+    static LayoutUndoStack *self();
+
+    ///@brief Destructor, called at shutdown
+    ~LayoutUndoStack() override;
+
+    bool canUndo() const;
+    bool canRedo() const;
+
+    ///@brief Returns the number of steps which can be undone
+    int undoCount() const;
+
+    ///@brief Returns the number of steps which can be redone
+    int redoCount() const;
+
+    ///@brief Returns the layout to how it was before the last operation. Returns false if there's nothing to undo.
+    Q_INVOKABLE bool undo();
+
+    ///@brief Re-applies the last undone operation. Returns false if there's nothing to redo.
+    Q_INVOKABLE bool redo();
+
+    ///@brief Discards all steps
+    Q_INVOKABLE void clear();
+
+    /**
+     * @brief Remembers the current layout as the one to go back to when undoing the next operation.
+     *
+     * Calls don't nest. Calling it again before endOperation() simply remembers the layout again.
+     */
+    void beginOperation();
+
+    /**
+     * @brief Records a step if the layout changed since beginOperation()
+     *
+     * The comparison is done in the next event loop iteration, so deferred deletions have run.
+     * Does nothing if beginOperation() wasn't called.
+     */
+    void endOperation();
+
+    /**
+     * @brief Forgets the layout remembered by beginOperation(), for operations which didn't happen
+     *
+     * Does nothing if endOperation() was already called.
+     */
+    void cancelOperation();
+
+    ///@brief RAII helper which calls beginOperation() and endOperation()
+    struct DOCKS_EXPORT Operation
+    {
+        Operation();
+        ~Operation();
+        Q_DISABLE_COPY(Operation)
+    };
+
+Q_SIGNALS:
+    void canUndoChanged(bool);
+    void canRedoChanged(bool);
+
+private:
+    friend class ::TestDocks;
+    friend class Config;
+    class Private;
+    Private *const d;
+    LayoutUndoStack();
+    void trim();
+};
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "Config.h"
+#include "private/InputRecorder_p.h"
+
+#include "DockWidget.h"
+#include "MainWindow.h"
+
+#include <QApplication>
+#include <QDebug>
+#include <QString>
+
+using namespace KDDockWidgets;
+
+static void printTimings(const char *name, const DragPhaseStatistics &stats)
+{
+    qDebug().nospace() << name << ": count=" << stats.count
+                       << "; p50=" << stats.p50 / 1000 << "us"
+                       << "; p95=" << stats.p95 / 1000 << "us"
+                       << "; max=" << stats.max / 1000 << "us";
+}
+
+static bool replay(const QString &filename, bool honourTimestamps)
+{
+    DockWidgetFactoryFunc dwFunc = [](const QString &dwName) {
+        return static_cast<DockWidgetBase *>(new DockWidgetType(dwName));
+    };
+
+    MainWindowFactoryFunc mwFunc = [](const QString &dwName) {
+        return static_cast<MainWindowBase *>(new MainWindowType(dwName));
+    };
+
+    KDDockWidgets::Config::self().setDockWidgetFactoryFunc(dwFunc);
+    KDDockWidgets::Config::self().setMainWindowFactoryFunc(mwFunc);
+    KDDockWidgets::Config::self().setDragStatisticsEnabled(true);
+    KDDockWidgets::Config::self().setDragStatisticsFunc([](const DragStatistics &stats) {
+        qDebug() << "Drag finished. dropped=" << stats.dropped << "; moves=" << stats.numMouseMoves
+                 << "; suggestedDropRect calls=" << stats.numSuggestedDropRectCalls;
+        printTimings("  Dragging", stats.phase(DragPhase::Dragging));
+        printTimings("  DropAreaHover", stats.phase(DragPhase::DropAreaHover));
+        printTimings("  IndicatorsHover", stats.phase(DragPhase::IndicatorsHover));
+        printTimings("  Drop", stats.phase(DragPhase::Drop));
+    });
+
+    InputReplayer replayer;
+    if (!replayer.loadFromFile(filename) || !replayer.restoreInitialLayout())
+        return false;
+
+    const InputReplayer::Result result = replayer.replay(honourTimestamps);
+    qDebug() << "Replayed" << result.numEvents << "events in" << result.totalNs / 1000000 << "ms;"
+             << result.numSkippedEvents << "skipped";
+    printTimings("Press", result.pressTimings);
+    printTimings("Move", result.moveTimings);
+    printTimings("Release", result.releaseTimings);
+
+    return result.numSkippedEvents == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    // Replays are benchmarks, they shouldn't depend on the window manager
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+
+    QStringList args = app.arguments();
+    const bool honourTimestamps = args.removeAll(QStringLiteral("--realtime")) > 0;
+
+    if (args.size() != 2) {
+        qDebug() << "Usage: kddockwidgets_replay [--realtime] <recording json file>";
+        return 1;
+    }
+
+    return replay(args.at(1), honourTimestamps) ? 0 : 2;
+}
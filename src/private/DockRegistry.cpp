@@ -11,9 +11,11 @@
 
 #include "DockRegistry_p.h"
 #include "Config.h"
+#include "LayoutSnapshot.h"
 #include "DockWidgetBase.h"
 #include "DockWidgetBase_p.h"
 #include "FloatingWindow_p.h"
+#include "Frame_p.h"
 #include "LayoutWidget_p.h"
 #include "Logging_p.h"
 #include "MainWindowMDI.h"
@@ -26,8 +28,10 @@
 #include "multisplitter/Item_p.h"
 
 #include <QPointer>
+#include <QScopedValueRollback>
 #include <QDebug>
 #include <QGuiApplication>
+#include <QTimer>
 #include <QWindow>
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
@@ -69,6 +73,9 @@ DockRegistry::DockRegistry(QObject *parent)
 
     connect(qApp, &QGuiApplication::focusObjectChanged,
             this, &DockRegistry::onFocusObjectChanged);
+    connect(qApp, &QGuiApplication::focusObjectChanged,
+            this, &DockRegistry::updateFocusScopes);
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &DockRegistry::clearPools);
 
     initKDDockWidgetResources();
 }
@@ -79,8 +86,19 @@ DockRegistry::~DockRegistry()
 
 void DockRegistry::maybeDelete()
 {
-    if (isEmpty())
-        delete this;
+    // Deleting a pooled floating window unregisters it, which brings us here again
+    if (!isEmpty() || m_isClearingPools)
+        return;
+
+    clearPools();
+    delete this;
+}
+
+void DockRegistry::clearPools()
+{
+    QScopedValueRollback<bool> guard(m_isClearingPools, true);
+    Frame::trimFramePool(0);
+    FloatingWindow::clearPool();
 }
 
 void DockRegistry::onFocusObjectChanged(QObject *obj)
@@ -108,6 +126,35 @@ void DockRegistry::onFocusObjectChanged(QObject *obj)
     setFocusedDockWidget(nullptr);
 }
 
+void DockRegistry::updateFocusScopes(QObject *focusObject)
+{
+    // Walk the focus object's ancestry once, instead of each FocusScope walking it
+    QVector<WidgetType *> focusedScopeWidgets;
+    auto p = qobject_cast<WidgetType *>(focusObject);
+    while (p) {
+        if (m_focusScopes.contains(p))
+            focusedScopeWidgets << p;
+        p = KDDockWidgets::Private::parentWidget(p);
+    }
+
+    // Only scopes which had or have the focus need to know. Scopes are looked up again each time,
+    // as the callbacks can destroy them.
+    const QVector<WidgetType *> previouslyFocusedScopeWidgets = m_focusedScopeWidgets;
+    m_focusedScopeWidgets = focusedScopeWidgets;
+
+    for (WidgetType *w : previouslyFocusedScopeWidgets) {
+        if (!focusedScopeWidgets.contains(w)) {
+            if (FocusScope *scope = m_focusScopes.value(w))
+                scope->onFocusObjectChanged(focusObject, false);
+        }
+    }
+
+    for (WidgetType *w : qAsConst(focusedScopeWidgets)) {
+        if (FocusScope *scope = m_focusScopes.value(w))
+            scope->onFocusObjectChanged(focusObject, true);
+    }
+}
+
 void DockRegistry::setFocusedDockWidget(DockWidgetBase *dw)
 {
     if (m_focusedDockWidget.data() == dw)
@@ -258,6 +305,61 @@ Frame *DockRegistry::frameInMDIResize() const
     return nullptr;
 }
 
+void DockRegistry::scheduleLayoutSnapshot()
+{
+    if (m_layoutSnapshotScheduled || !Config::self().layoutSnapshotsEnabled())
+        return;
+
+    m_layoutSnapshotScheduled = true;
+    QTimer::singleShot(0, this, &DockRegistry::publishLayoutSnapshot);
+}
+
+void DockRegistry::publishLayoutSnapshot()
+{
+    m_layoutSnapshotScheduled = false;
+    if (!Config::self().layoutSnapshotsEnabled()) {
+        LayoutSnapshot::publish(nullptr);
+        return;
+    }
+
+    std::shared_ptr<LayoutSnapshot> snapshot(new LayoutSnapshot());
+
+    QHash<const Frame *, int> frameIndexes;
+    snapshot->m_frames.reserve(m_frames.size());
+    for (Frame *frame : qAsConst(m_frames)) {
+        LayoutSnapshot::FrameInfo info;
+        info.dockWidgets.reserve(frame->dockWidgetCount());
+        frame->forEachDockWidget([&info](DockWidgetBase *dw) {
+            info.dockWidgets << dw->uniqueName();
+        });
+
+        info.currentIndex = frame->currentIndex();
+        info.globalGeometry = QRect(frame->mapToGlobal(QPoint(0, 0)), frame->QWidgetAdapter::geometry().size());
+        info.isVisible = frame->QWidgetAdapter::isVisible();
+        info.isFloating = frame->isFloating();
+        if (MainWindowBase *mw = frame->mainWindow())
+            info.mainWindow = mw->uniqueName();
+
+        frameIndexes.insert(frame, snapshot->m_frames.size());
+        snapshot->m_frames.push_back(info);
+    }
+
+    snapshot->m_dockWidgets.reserve(m_dockWidgets.size());
+    for (DockWidgetBase *dw : qAsConst(m_dockWidgets)) {
+        LayoutSnapshot::DockWidgetInfo info;
+        info.uniqueName = dw->uniqueName();
+        info.frameIndex = frameIndexes.value(dw->d->frame(), -1);
+        info.globalGeometry = QRect(dw->mapToGlobal(QPoint(0, 0)), dw->geometry().size());
+        info.isOpen = dw->isOpen();
+        info.isVisible = dw->isVisible();
+        info.isCurrentTab = dw->isCurrentTab();
+        info.isFloating = dw->isFloating();
+        snapshot->m_dockWidgets.push_back(info);
+    }
+
+    LayoutSnapshot::publish(std::move(snapshot));
+}
+
 MainWindowBase::List DockRegistry::mainWindowsWithAffinity(const QStringList &affinities) const
 {
     MainWindowBase::List result;
@@ -312,6 +414,7 @@ void DockRegistry::registerDockWidget(DockWidgetBase *dock)
     }
 
     m_dockWidgets << dock;
+    scheduleLayoutSnapshot();
 }
 
 void DockRegistry::unregisterDockWidget(DockWidgetBase *dock)
@@ -320,6 +423,7 @@ void DockRegistry::unregisterDockWidget(DockWidgetBase *dock)
         m_focusedDockWidget = nullptr;
 
     m_dockWidgets.removeOne(dock);
+    scheduleLayoutSnapshot();
     maybeDelete();
 }
 
@@ -364,11 +468,43 @@ void DockRegistry::unregisterLayout(LayoutWidget *layout)
 void DockRegistry::registerFrame(Frame *frame)
 {
     m_frames << frame;
+
+    // Unique, as recycled frames are registered again
+    connect(frame, &Frame::numDockWidgetsChanged, this, &DockRegistry::scheduleLayoutSnapshot, Qt::UniqueConnection);
+    connect(frame, &Frame::currentDockWidgetChanged, this, &DockRegistry::scheduleLayoutSnapshot, Qt::UniqueConnection);
+#ifdef KDDOCKWIDGETS_QTQUICK
+    // QQuickItems don't get Show/Hide/Move/Resize events, which our event filter handles for QtWidgets
+    for (auto signal : { &QQuickItem::visibleChanged, &QQuickItem::xChanged, &QQuickItem::yChanged,
+                         &QQuickItem::widthChanged, &QQuickItem::heightChanged })
+        connect(frame, signal, this, &DockRegistry::scheduleLayoutSnapshot, Qt::UniqueConnection);
+#endif
+
+    scheduleLayoutSnapshot();
 }
 
 void DockRegistry::unregisterFrame(Frame *frame)
 {
     m_frames.removeOne(frame);
+    scheduleLayoutSnapshot();
+}
+
+void DockRegistry::registerFocusScope(FocusScope *scope)
+{
+    WidgetType *w = scope->scopeWidget();
+    m_focusScopes.insert(w, scope);
+
+    if (scope->isInFocusScope(qobject_cast<WidgetType *>(qApp->focusObject())))
+        m_focusedScopeWidgets << w;
+}
+
+void DockRegistry::unregisterFocusScope(FocusScope *scope)
+{
+    WidgetType *w = scope->scopeWidget();
+    if (m_focusScopes.value(w) != scope)
+        return;
+
+    m_focusScopes.remove(w);
+    m_focusedScopeWidgets.removeOne(w);
 }
 
 DockWidgetBase *DockRegistry::focusedDockWidget() const
@@ -712,6 +848,15 @@ bool DockRegistry::eventFilter(QObject *watched, QEvent *event)
                 m_floatingWindows.append(fw);
             }
         }
+    } else if (event->type() == QEvent::Move || event->type() == QEvent::Resize
+               || event->type() == QEvent::Show || event->type() == QEvent::Hide) {
+        // Frames change geometry when the layout commits, top-levels when the user moves them
+        if (Config::self().layoutSnapshotsEnabled() && !m_layoutSnapshotScheduled
+            && (qobject_cast<Frame *>(watched) || qobject_cast<QWindow *>(watched)))
+            scheduleLayoutSnapshot();
+    } else if (event->type() == QEvent::WindowActivate || event->type() == QEvent::WindowDeactivate) {
+        // Dispatched from here, instead of each dock widget filtering every application event
+        onWindowActivationChanged(watched, event->type() == QEvent::WindowActivate);
     } else if (event->type() == QEvent::MouseButtonPress) {
         // When clicking on a MDI Frame we raise the window
         if (Frame *f = firstParentOfType<Frame>(watched)) {
@@ -749,6 +894,20 @@ bool DockRegistry::eventFilter(QObject *watched, QEvent *event)
     return false;
 }
 
+void DockRegistry::onWindowActivationChanged(QObject *window, bool activated)
+{
+    // Activation changes are rare, so there's no point in keeping a window to dock widgets index
+    // up to date on every reparenting. Instead, group the dock widgets of that window only now.
+    QVector<DockWidgetBase *> docks;
+    for (DockWidgetBase *dw : qAsConst(m_dockWidgets)) {
+        if (dw->window() == window)
+            docks << dw;
+    }
+
+    for (DockWidgetBase *dw : qAsConst(docks))
+        Q_EMIT dw->windowActiveAboutToChange(activated);
+}
+
 bool DockRegistry::onDockWidgetPressed(DockWidgetBase *dw, QMouseEvent *ev)
 {
     // Here we implement "auto-hide". If there's a overlayed dock widget, we hide it if some other
@@ -65,6 +65,10 @@ public:
     void registerFrame(Frame *);
     void unregisterFrame(Frame *);
 
+    ///@brief Registers a FocusScope, so it's told when focus enters or leaves it
+    void registerFocusScope(FocusScope *);
+    void unregisterFocusScope(FocusScope *);
+
     Q_INVOKABLE KDDockWidgets::DockWidgetBase *focusedDockWidget() const;
 
     Q_INVOKABLE bool containsDockWidget(const QString &uniqueName) const;
@@ -173,6 +177,9 @@ public:
      *
      * @param dumpDebug If true then each layout is dumped too
      *
+     * Layouts only validate what changed since their last successful check, so this is cheap
+     * if little changed. See Layouting::Item::s_fullSanityChecks.
+     *
      * This is called by the unit-tests. If during this the framework spits a
      * qWarning() then the app will qFatal()
      */
@@ -226,6 +233,13 @@ public:
     ///@brief Returns the Frame which is being resized in a MDI layout. nullptr if none
     Frame *frameInMDIResize() const;
 
+    ///@brief Publishes a new LayoutSnapshot in the next event loop iteration, if enabled.
+    /// Calling it several times in the same iteration only publishes once.
+    void scheduleLayoutSnapshot();
+
+    ///@brief Publishes a new LayoutSnapshot now. Publishes nullptr if snapshots are disabled.
+    void publishLayoutSnapshot();
+
 Q_SIGNALS:
     /// @brief emitted when a main window or a floating window change screen
     void windowChangedScreen(QWindow *);
@@ -243,17 +257,27 @@ private:
     friend class FocusScope;
     explicit DockRegistry(QObject *parent = nullptr);
     bool onDockWidgetPressed(DockWidgetBase *dw, QMouseEvent *);
+    void onWindowActivationChanged(QObject *window, bool activated);
     void onFocusObjectChanged(QObject *obj);
+    void updateFocusScopes(QObject *focusObject);
     void maybeDelete();
     void setFocusedDockWidget(DockWidgetBase *);
 
+    /// @brief Deletes the pooled frames and floating windows
+    /// They're not registered, so nothing else deletes them at shutdown.
+    void clearPools();
+
     bool m_isProcessingAppQuitEvent = false;
+    bool m_isClearingPools = false;
+    bool m_layoutSnapshotScheduled = false;
     DockWidgetBase::List m_dockWidgets;
     MainWindowBase::List m_mainWindows;
     QList<Frame *> m_frames;
     QVector<FloatingWindow *> m_floatingWindows;
     QVector<LayoutWidget *> m_layouts;
     QPointer<DockWidgetBase> m_focusedDockWidget;
+    QHash<WidgetType *, FocusScope *> m_focusScopes;
+    QVector<WidgetType *> m_focusedScopeWidgets; // The widgets of the scopes containing the focus object
 
     ///@brief Dock widget id remapping, used by LayoutSaver
     ///
@@ -21,9 +21,11 @@
 #include <QCoreApplication>
 #include <QString>
 #include <QSize>
+#include <QVariant>
 
 QT_BEGIN_NAMESPACE
 class QAction;
+class QTimer;
 QT_END_NAMESPACE
 
 namespace KDDockWidgets {
@@ -85,8 +87,6 @@ public:
     void forceClose();
     QPoint defaultCenterPosForFloating();
 
-    bool eventFilter(QObject *watched, QEvent *event) override;
-
     void updateTitle();
     void toggle(bool enabled);
     void updateToggleAction();
@@ -147,6 +147,22 @@ public:
     /// This goes up the hierarchy, while mdiDropAreaWrapper goes down.
     DockWidgetBase *mdiDockWidgetWrapper() const;
 
+    /// @brief Called when closed. Hibernates the guest later, according to the policy in Config
+    void scheduleHibernation();
+
+    /// @brief Destroys the guest widget, after saving its state
+    /// Only possible while closed or in a non-current tab. Returns whether it hibernated.
+    bool hibernate();
+
+    /// @brief Recreates the guest widget if hibernated and cancels any pending hibernation
+    void wakeUp();
+
+    /// @brief Hibernates the least recently closed dock widgets while over Config::hibernationBudget()
+    static void enforceHibernationBudget();
+
+    /// @brief Cancels pending hibernations if Config::hibernationTimeout() was disabled
+    static void onHibernationTimeoutChanged();
+
     const QString name;
     QStringList affinities;
     QString title;
@@ -168,6 +184,12 @@ public:
     bool m_isMovingToSideBar = false;
     QSize m_lastOverlayedSize = QSize(0, 0);
     int m_userType = 0;
+    DockWidgetBase::GuestStateSaverFunc m_guestStateSaver = nullptr;
+    DockWidgetBase::GuestWidgetFactoryFunc m_guestWidgetFactory = nullptr;
+    QVariant m_hibernatedState;
+    QTimer *m_hibernationTimer = nullptr;
+    qint64 m_guestCost = 1;
+    bool m_isHibernated = false;
 };
 }
 
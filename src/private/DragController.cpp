@@ -12,6 +12,7 @@
 #include "DragController_p.h"
 #include "DockRegistry_p.h"
 #include "DockWidgetBase_p.h"
+#include "DragStatistics_p.h"
 #include "DropArea_p.h"
 #include "FloatingWindow_p.h"
 #include "Frame_p.h"
@@ -20,8 +21,10 @@
 #include "Utils_p.h"
 #include "WidgetResizeHandler_p.h"
 #include "Config.h"
+#include "LayoutUndoStack.h"
 #include "MDILayoutWidget_p.h"
 #include "WindowZOrder_x11_p.h"
+#include "multisplitter/Item_p.h"
 
 #include <QMouseEvent>
 #include <QGuiApplication>
@@ -29,6 +32,13 @@
 #include <QWindow>
 #include <QDrag>
 #include <QScopedValueRollback>
+#include <QScreen>
+#include <QRasterWindow>
+#include <QPainter>
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+#include <QQuickWindow>
+#endif
 
 #if defined(Q_OS_WIN)
 #include <windows.h>
@@ -97,6 +107,44 @@ FallbackMouseGrabber::~FallbackMouseGrabber()
 {
 }
 
+static QPixmap snapshotForWindow(FloatingWindow *fw)
+{
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    return fw->grab();
+#else
+    if (auto quickWindow = qobject_cast<QQuickWindow *>(fw->windowHandle()))
+        return QPixmap::fromImage(quickWindow->grabWindow());
+    return {};
+#endif
+}
+
+///@brief Translucent window showing a snapshot of the window being dragged
+/// Used with Config::Flag_LightweightDragProxy. Moving it is cheap, as it only has a pixmap to show.
+class DragProxyWindow : public QRasterWindow /// clazy:exclude=missing-qobject-macro
+{
+public:
+    explicit DragProxyWindow(FloatingWindow *fw)
+        : m_pixmap(snapshotForWindow(fw))
+    {
+        setFlags(Qt::Tool | Qt::FramelessWindowHint | Qt::WindowStaysOnTopHint | Qt::WindowTransparentForInput | Qt::WindowDoesNotAcceptFocus);
+        setObjectName(QStringLiteral("_docks_DragProxyWindow"));
+
+        const qreal opacity = Config::self().draggedWindowOpacity();
+        setOpacity(qIsNaN(opacity) || qFuzzyCompare(1.0, opacity) ? 0.7 : opacity);
+        setGeometry(fw->windowHandle()->geometry());
+    }
+
+protected:
+    void paintEvent(QPaintEvent *) override
+    {
+        QPainter p(this);
+        p.drawPixmap(0, 0, m_pixmap);
+    }
+
+private:
+    const QPixmap m_pixmap;
+};
+
 }
 
 State::State(MinimalStateMachine *parent)
@@ -182,6 +230,10 @@ void StateNone::onEntry()
         q->m_currentDropArea = nullptr;
     }
 
+    DragStatistics statistics;
+    if (DragStatisticsCollector::self()->endSession(statistics))
+        q->reportDragStatistics(statistics);
+
     Q_EMIT q->isDraggingChanged();
 }
 
@@ -214,11 +266,14 @@ StatePreDrag::~StatePreDrag() = default;
 void StatePreDrag::onEntry()
 {
     qCDebug(state) << "StatePreDrag entered" << q->m_draggableGuard.data();
+    DragStatisticsCollector::self()->beginSession();
     WidgetResizeHandler::s_disableAllHandlers = true; // Disable the resize handler during dragging
 }
 
 bool StatePreDrag::handleMouseMove(QPoint globalPos)
 {
+    ScopedDragPhaseTimer timer(DragPhase::PreDrag);
+
     if (!q->m_draggableGuard) {
         qWarning() << Q_FUNC_INFO << "Draggable was destroyed, canceling the drag";
         Q_EMIT q->dragCanceled();
@@ -268,13 +323,40 @@ StateDragging::StateDragging(DragController *parent)
         }
     });
 #endif
+
+    // For Config::Flag_CoalesceDragMouseMoves. The frame timer paces window moves, while the hover
+    // timer runs the more expensive drop area hovering only after pending events were processed,
+    // so it never delays moving the window.
+    m_frameTimer.setSingleShot(true);
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameTimer, &QTimer::timeout, this, &StateDragging::processPendingMouseMove);
+    m_hoverTimer.setSingleShot(true);
+    m_hoverTimer.setInterval(0);
+    connect(&m_hoverTimer, &QTimer::timeout, this, &StateDragging::processPendingHover);
 }
 
 StateDragging::~StateDragging() = default;
 
+static bool coalescesDragMouseMoves()
+{
+    return Config::self().flags() & Config::Flag_CoalesceDragMouseMoves;
+}
+
+static bool usesLightweightDragProxy()
+{
+    // Without translucency the proxy would just look like a second window
+    return (Config::self().flags() & Config::Flag_LightweightDragProxy) && KDDockWidgets::windowManagerHasTranslucency();
+}
+
 void StateDragging::onEntry()
 {
+    // Undocking changes the layout right away. A natively moved window changes without us knowing.
+    // Otherwise it's only remembered once the window moves or is dropped.
+    if (!q->m_draggable->isWindow() || q->m_nonClientDrag)
+        beginUndoOperation();
+
     m_maybeCancelDrag.start();
+    DragStatisticsCollector::self()->markDragStarted();
 
     if (DockWidgetBase *dw = q->m_draggable->singleDockWidget()) {
         // When we start to drag a floating window which has a single dock widget, we save the position
@@ -313,6 +395,11 @@ void StateDragging::onEntry()
                        << "; m_windowBeingDragged=" << q->m_windowBeingDragged->floatingWindow();
 
         auto fw = q->m_windowBeingDragged->floatingWindow();
+        if (coalescesDragMouseMoves()) {
+            QWindow *window = fw->windowHandle();
+            m_frameTimer.setInterval(Layouting::frameInterval(window ? window->screen() : nullptr));
+        }
+
 #ifdef Q_OS_LINUX
         if (fw->isMaximizedOverride()) {
             // When dragging a maximized window on linux we need to restore its normal size
@@ -351,6 +438,14 @@ void StateDragging::onEntry()
                 q->m_offset.setX(fw->width() / 2);
             }
         }
+
+        if (!q->m_nonClientDrag && usesLightweightDragProxy()) {
+            // Only the proxy follows the mouse. The real window stays mapped, so it keeps the mouse grab,
+            // but invisible and in place. It's only moved when the drag ends.
+            q->m_dragProxyWindow.reset(new DragProxyWindow(fw));
+            q->m_dragProxyWindow->show();
+            fw->setWindowOpacity(0);
+        }
     } else {
         // Shouldn't happen
         qWarning() << Q_FUNC_INFO << "No window being dragged for " << q->m_draggable->asWidget();
@@ -363,6 +458,40 @@ void StateDragging::onEntry()
 void StateDragging::onExit()
 {
     m_maybeCancelDrag.stop();
+    m_frameTimer.stop();
+    m_hoverTimer.stop();
+    m_hasPendingMouseMove = false;
+    m_hasPendingHover = false;
+    hideDragProxy();
+
+    if (m_undoOperationStarted) {
+        m_undoOperationStarted = false;
+        LayoutUndoStack::self()->endOperation();
+    }
+}
+
+void StateDragging::beginUndoOperation()
+{
+    if (!m_undoOperationStarted) {
+        m_undoOperationStarted = true;
+        LayoutUndoStack::self()->beginOperation();
+    }
+}
+
+void StateDragging::hideDragProxy()
+{
+    if (!q->m_dragProxyWindow)
+        return;
+
+    FloatingWindow *fw = q->floatingWindowBeingDragged();
+    if (fw && !fw->beingDeleted()) {
+        // It wasn't dropped into a layout, so it now goes where the proxy was
+        beginUndoOperation();
+        fw->windowHandle()->setPosition(q->m_dragProxyWindow->position());
+        fw->setWindowOpacity(1);
+    }
+
+    q->m_dragProxyWindow.reset();
 }
 
 bool StateDragging::handleMouseButtonRelease(QPoint globalPos)
@@ -383,7 +512,13 @@ bool StateDragging::handleMouseButtonRelease(QPoint globalPos)
         return true;
     }
 
+    // Make sure the drop area reflects the last mouse move
+    flushPendingMouseMove();
+    if (!isActiveState())
+        return true;
+
     if (q->m_currentDropArea) {
+        beginUndoOperation();
         if (q->m_currentDropArea->drop(q->m_windowBeingDragged.get(), globalPos)) {
             Q_EMIT q->dropped();
         } else {
@@ -399,6 +534,58 @@ bool StateDragging::handleMouseButtonRelease(QPoint globalPos)
 
 bool StateDragging::handleMouseMove(QPoint globalPos)
 {
+    if (!coalescesDragMouseMoves())
+        return processMouseMove(globalPos);
+
+    if (m_frameTimer.isActive()) {
+        // We already moved during this frame. Only the latest position will be processed.
+        m_pendingMousePos = globalPos;
+        m_hasPendingMouseMove = true;
+        return true;
+    }
+
+    m_frameTimer.start();
+    return processMouseMove(globalPos);
+}
+
+void StateDragging::processPendingMouseMove()
+{
+    if (!m_hasPendingMouseMove)
+        return;
+
+    m_hasPendingMouseMove = false;
+    m_frameTimer.start();
+    processMouseMove(m_pendingMousePos);
+}
+
+void StateDragging::processPendingHover()
+{
+    if (!m_hasPendingHover)
+        return;
+
+    m_hasPendingHover = false;
+    if (q->floatingWindowBeingDragged())
+        hoverDropArea(m_pendingHoverPos);
+}
+
+void StateDragging::flushPendingMouseMove()
+{
+    m_frameTimer.stop();
+    m_hoverTimer.stop();
+
+    if (m_hasPendingMouseMove) {
+        m_hasPendingMouseMove = false;
+        processMouseMove(m_pendingMousePos);
+        m_hoverTimer.stop();
+    }
+
+    processPendingHover();
+}
+
+bool StateDragging::processMouseMove(QPoint globalPos)
+{
+    ScopedDragPhaseTimer timer(DragPhase::Dragging);
+
     FloatingWindow *fw = q->m_windowBeingDragged->floatingWindow();
     if (!fw) {
         qCDebug(state) << "Canceling drag, window was deleted";
@@ -423,14 +610,32 @@ bool StateDragging::handleMouseMove(QPoint globalPos)
     }
 #endif
 
-    if (!q->m_nonClientDrag)
+    if (q->m_dragProxyWindow) {
+        q->m_dragProxyWindow->setPosition(globalPos - q->m_offset);
+    } else if (!q->m_nonClientDrag) {
+        beginUndoOperation();
         fw->windowHandle()->setPosition(globalPos - q->m_offset);
+    }
 
     if (fw->anyNonDockable()) {
         qCDebug(state) << "StateDragging: Ignoring non dockable floating window";
         return true;
     }
 
+    if (coalescesDragMouseMoves()) {
+        // Hovering is deferred until pending events are processed, it can be expensive
+        m_pendingHoverPos = globalPos;
+        m_hasPendingHover = true;
+        if (!m_hoverTimer.isActive())
+            m_hoverTimer.start();
+        return true;
+    }
+
+    return hoverDropArea(globalPos);
+}
+
+bool StateDragging::hoverDropArea(QPoint globalPos)
+{
     DropArea *dropArea = q->dropAreaUnderCursor();
     if (q->m_currentDropArea && dropArea != q->m_currentDropArea)
         q->m_currentDropArea->removeHover();
@@ -472,6 +677,7 @@ void StateInternalMDIDragging::onEntry()
 {
     qCDebug(state) << "StateInternalMDIDragging entered. draggable="
                    << q->m_draggable->asWidget();
+    DragStatisticsCollector::self()->markDragStarted();
 
     // Raise the dock widget being dragged
     if (auto tb = qobject_cast<TitleBar *>(q->m_draggable->asWidget())) {
@@ -490,6 +696,8 @@ bool StateInternalMDIDragging::handleMouseButtonRelease(QPoint)
 
 bool StateInternalMDIDragging::handleMouseMove(QPoint globalPos)
 {
+    ScopedDragPhaseTimer timer(DragPhase::InternalMDIDragging);
+
     // for MDI we only support dragging via the title bar, other cases don't make sense conceptually
     auto tb = qobject_cast<TitleBar *>(q->m_draggable->asWidget());
     if (!tb) {
@@ -551,6 +759,7 @@ StateDraggingWayland::~StateDraggingWayland()
 void StateDraggingWayland::onEntry()
 {
     qCDebug(state) << "StateDragging entered";
+    DragStatisticsCollector::self()->markDragStarted();
 
     if (m_inQDrag) {
         // Maybe we can exit the state due to the nested event loop of QDrag::Exec();
@@ -620,6 +829,7 @@ bool StateDraggingWayland::handleDrop(QDropEvent *ev, DropArea *dropArea)
     if (!mimeData || !q->m_windowBeingDragged)
         return false; // Not for us, some other user drag.
 
+    beginUndoOperation();
     if (dropArea->drop(q->m_windowBeingDragged.get(), dropArea->mapToGlobal(Qt5Qt6Compat::eventPos(ev)))) {
         ev->setDropAction(Qt::MoveAction);
         ev->accept();
@@ -654,6 +864,11 @@ DragController::DragController(QObject *parent)
                                      : new StateDragging(this);
     m_stateDraggingMDI = new StateInternalMDIDragging(this);
 
+    // Connected before the state transitions, so the drop is known before StateNone reports the statistics
+    connect(this, &DragController::dropped, this, [] {
+        DragStatisticsCollector::self()->markDropped();
+    });
+
     m_stateNone->addTransition(this, &DragController::mousePressed, statepreDrag);
     statepreDrag->addTransition(this, &DragController::dragCanceled, m_stateNone);
     statepreDrag->addTransition(this, &DragController::manhattanLengthMove, stateDragging);
@@ -670,6 +885,8 @@ DragController::DragController(QObject *parent)
     setCurrentState(m_stateNone);
 }
 
+DragController::~DragController() = default;
+
 DragController *DragController::instance()
 {
     static DragController dragController;
@@ -678,13 +895,13 @@ DragController *DragController::instance()
 
 void DragController::registerDraggable(Draggable *drg)
 {
-    m_draggables << drg;
+    m_draggables.insert(drg->asWidget(), drg);
     drg->asWidget()->installEventFilter(this);
 }
 
 void DragController::unregisterDraggable(Draggable *drg)
 {
-    m_draggables.removeOne(drg);
+    m_draggables.remove(drg->asWidget());
     drg->asWidget()->removeEventFilter(this);
 }
 
@@ -749,8 +966,20 @@ WindowBeingDragged *DragController::windowBeingDragged() const
     return m_windowBeingDragged.get();
 }
 
+QWindow *DragController::dragProxyWindow() const
+{
+    return m_dragProxyWindow.get();
+}
+
 bool DragController::eventFilter(QObject *o, QEvent *e)
 {
+    if (activeState() == m_stateNone) {
+        // Fast path for the common case. While idle only a press can start a drag, StateNone ignores everything else.
+        const QEvent::Type type = e->type();
+        if (type != QEvent::MouseButtonPress && type != QEvent::NonClientAreaMouseButtonPress)
+            return MinimalStateMachine::eventFilter(o, e);
+    }
+
     if (m_nonClientDrag && e->type() == QEvent::Move) {
         // On Windows, non-client mouse moves are only sent at the end, so we must fake it:
         qCDebug(mouseevents) << "DragController::eventFilter e=" << e->type() << "; o=" << o;
@@ -819,6 +1048,7 @@ bool DragController::eventFilter(QObject *o, QEvent *e)
         return activeState()->handleMouseButtonRelease(Qt5Qt6Compat::eventGlobalPos(me));
     case QEvent::NonClientAreaMouseMove:
     case QEvent::MouseMove:
+        DragStatisticsCollector::self()->addMouseMove();
         return activeState()->handleMouseMove(Qt5Qt6Compat::eventGlobalPos(me));
     case QEvent::MouseButtonDblClick:
     case QEvent::NonClientAreaMouseButtonDblClick:
@@ -835,6 +1065,21 @@ StateBase *DragController::activeState() const
     return static_cast<StateBase *>(currentState());
 }
 
+DragStatistics DragController::lastDragStatistics() const
+{
+    return m_lastDragStatistics;
+}
+
+void DragController::reportDragStatistics(const DragStatistics &statistics)
+{
+    m_lastDragStatistics = statistics;
+
+    if (auto func = Config::self().dragStatisticsFunc())
+        func(statistics);
+
+    Q_EMIT dragStatisticsAvailable(statistics);
+}
+
 #if defined(Q_OS_WIN)
 static QWidgetOrQuick *qtTopLevelForHWND(HWND hwnd)
 {
@@ -1030,10 +1275,5 @@ DropArea *DragController::dropAreaUnderCursor() const
 
 Draggable *DragController::draggableForQObject(QObject *o) const
 {
-    for (auto draggable : m_draggables)
-        if (draggable->asWidget() == o) {
-            return draggable;
-        }
-
-    return nullptr;
+    return m_draggables.value(o);
 }
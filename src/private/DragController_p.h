@@ -18,6 +18,7 @@
 #include "WindowBeingDragged_p.h"
 
 #include <QPoint>
+#include <QHash>
 #include <QMimeData>
 #include <QTimer>
 
@@ -31,6 +32,7 @@ class StateInternalMDIDragging;
 class DropArea;
 class Draggable;
 class FallbackMouseGrabber;
+class DragProxyWindow;
 class MinimalStateMachine;
 
 class State : public QObject
@@ -81,6 +83,7 @@ public:
     };
     Q_ENUM(State)
 
+    ~DragController() override;
     static DragController *instance();
 
     // Registers something that wants to be able to be dragged
@@ -103,12 +106,20 @@ public:
     ///@brief Returns the window being dragged
     WindowBeingDragged *windowBeingDragged() const;
 
+    ///@brief Returns the window following the mouse instead of the window being dragged
+    /// Only set while dragging with Config::Flag_LightweightDragProxy
+    QWindow *dragProxyWindow() const;
+
     /// Experimental, internal, not for general use.
     void enableFallbackMouseGrabber();
 
     // Returns the active state
     StateBase *activeState() const;
 
+    /// @brief Returns the statistics of the last finished drag
+    /// Only filled if Config::dragStatisticsEnabled() is true
+    DragStatistics lastDragStatistics() const;
+
 Q_SIGNALS:
     void mousePressed();
     void manhattanLengthMove();
@@ -118,6 +129,9 @@ Q_SIGNALS:
     void dropped();
     void isDraggingChanged();
 
+    /// @brief emitted when a drag finishes, if Config::dragStatisticsEnabled() is true
+    void dragStatisticsAvailable(const KDDockWidgets::DragStatistics &);
+
 protected:
     bool eventFilter(QObject *, QEvent *) override;
 
@@ -133,18 +147,21 @@ private:
     DragController(QObject * = nullptr);
     WidgetType *qtTopLevelUnderCursor() const;
     Draggable *draggableForQObject(QObject *o) const;
+    void reportDragStatistics(const DragStatistics &);
     QPoint m_pressPos;
     QPoint m_offset;
 
-    Draggable::List m_draggables;
+    QHash<QObject *, Draggable *> m_draggables;
     Draggable *m_draggable = nullptr;
     QPointer<WidgetType> m_draggableGuard; // Just so we know if the draggable was destroyed for some reason
     std::unique_ptr<WindowBeingDragged> m_windowBeingDragged;
+    std::unique_ptr<DragProxyWindow> m_dragProxyWindow;
     DropArea *m_currentDropArea = nullptr;
     bool m_nonClientDrag = false;
     FallbackMouseGrabber *m_fallbackMouseGrabber = nullptr;
     StateNone *m_stateNone = nullptr;
     StateInternalMDIDragging *m_stateDraggingMDI = nullptr;
+    DragStatistics m_lastDragStatistics;
 };
 
 class StateBase : public State
@@ -231,8 +248,28 @@ public:
     bool handleMouseMove(QPoint globalPos) override;
     bool handleMouseDoubleClick() override;
 
+protected:
+    ///@brief Remembers the layout for LayoutUndoStack, right before the drag first changes it
+    void beginUndoOperation();
+
 private:
+    bool processMouseMove(QPoint globalPos);
+    bool hoverDropArea(QPoint globalPos);
+    void processPendingMouseMove();
+    void processPendingHover();
+    void flushPendingMouseMove();
+    void hideDragProxy();
+
     QTimer m_maybeCancelDrag;
+
+    // The following are only used with Config::Flag_CoalesceDragMouseMoves
+    QTimer m_frameTimer;
+    QTimer m_hoverTimer;
+    QPoint m_pendingMousePos;
+    QPoint m_pendingHoverPos;
+    bool m_hasPendingMouseMove = false;
+    bool m_hasPendingHover = false;
+    bool m_undoOperationStarted = false;
 };
 
 
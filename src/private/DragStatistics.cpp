@@ -0,0 +1,113 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "DragStatistics_p.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace KDDockWidgets;
+
+DragStatisticsCollector *DragStatisticsCollector::self()
+{
+    static DragStatisticsCollector collector;
+    return &collector;
+}
+
+void DragStatisticsCollector::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (!enabled)
+        reset();
+}
+
+void DragStatisticsCollector::beginSession()
+{
+    reset();
+    if (!m_enabled)
+        return;
+
+    m_collecting = true;
+    m_sessionTimer.start();
+}
+
+void DragStatisticsCollector::markDragStarted()
+{
+    if (m_collecting)
+        m_dragStarted = true;
+}
+
+void DragStatisticsCollector::markDropped()
+{
+    if (m_collecting)
+        m_dropped = true;
+}
+
+bool DragStatisticsCollector::endSession(DragStatistics &result)
+{
+    if (!m_collecting || !m_dragStarted) {
+        reset();
+        return false;
+    }
+
+    result = {};
+    for (int i = 0; i < int(DragPhase::Count); ++i)
+        result.phases[i] = summarize(m_samples[i]);
+
+    result.numMouseMoves = m_numMouseMoves;
+    result.numSuggestedDropRectCalls = m_numSuggestedDropRectCalls;
+    result.durationMs = m_sessionTimer.elapsed();
+    result.dropped = m_dropped;
+
+    reset();
+    return true;
+}
+
+void DragStatisticsCollector::addSample(DragPhase phase, qint64 nsecs)
+{
+    if (m_collecting)
+        m_samples[int(phase)].push_back(nsecs);
+}
+
+DragPhaseStatistics DragStatisticsCollector::summarize(QVector<qint64> &samples)
+{
+    DragPhaseStatistics stats;
+    if (samples.isEmpty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest-rank percentiles
+    auto percentile = [&samples](double p) {
+        const auto rank = static_cast<int>(std::ceil(p * samples.size()));
+        return samples.at(qBound(0, rank - 1, int(samples.size()) - 1));
+    };
+
+    stats.count = int(samples.size());
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.max = samples.constLast();
+    for (qint64 sample : qAsConst(samples))
+        stats.total += sample;
+
+    return stats;
+}
+
+void DragStatisticsCollector::reset()
+{
+    m_collecting = false;
+    m_dragStarted = false;
+    m_dropped = false;
+    m_numMouseMoves = 0;
+    m_numSuggestedDropRectCalls = 0;
+    for (auto &samples : m_samples)
+        samples.clear();
+}
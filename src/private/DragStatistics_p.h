@@ -0,0 +1,113 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_DRAGSTATISTICS_P_H
+#define KD_DRAGSTATISTICS_P_H
+
+#include "kddockwidgets/KDDockWidgets.h"
+
+#include <QElapsedTimer>
+#include <QVector>
+
+namespace KDDockWidgets {
+
+/**
+ * @brief Accumulates the timings of the current drag, see Config::setDragStatisticsEnabled()
+ *
+ * A session starts when a draggable is pressed and ends when DragController goes back to idle.
+ * When disabled, the only cost is checking a bool.
+ *
+ * \internal
+ */
+class DOCKS_EXPORT DragStatisticsCollector
+{
+public:
+    static DragStatisticsCollector *self();
+
+    void setEnabled(bool);
+    bool isEnabled() const
+    {
+        return m_enabled;
+    }
+
+    /// @brief Returns whether we're enabled and in a drag session
+    bool isCollecting() const
+    {
+        return m_collecting;
+    }
+
+    void beginSession();
+    void markDragStarted();
+    void markDropped();
+
+    /// @brief Ends the current session and fills @p result
+    /// Returns false if there was no session or if the mouse was released before dragging started,
+    /// in which case there's nothing interesting to report.
+    bool endSession(DragStatistics &result);
+
+    void addSample(DragPhase, qint64 nsecs);
+    void addMouseMove()
+    {
+        if (m_collecting)
+            m_numMouseMoves++;
+    }
+
+    void addSuggestedDropRectCall()
+    {
+        if (m_collecting)
+            m_numSuggestedDropRectCalls++;
+    }
+
+    /// @brief Computes the percentiles for the specified samples. Sorts them in the process.
+    static DragPhaseStatistics summarize(QVector<qint64> &samples);
+
+private:
+    DragStatisticsCollector() = default;
+    void reset();
+
+    bool m_enabled = false;
+    bool m_collecting = false;
+    bool m_dragStarted = false;
+    bool m_dropped = false;
+    int m_numMouseMoves = 0;
+    int m_numSuggestedDropRectCalls = 0;
+    QElapsedTimer m_sessionTimer;
+    QVector<qint64> m_samples[int(DragPhase::Count)];
+};
+
+/// @brief RAII helper which times a DragPhase, if statistics are being collected
+class ScopedDragPhaseTimer
+{
+public:
+    explicit ScopedDragPhaseTimer(DragPhase phase)
+        : m_phase(phase)
+        , m_active(DragStatisticsCollector::self()->isCollecting())
+    {
+        if (m_active)
+            m_timer.start();
+    }
+
+    ~ScopedDragPhaseTimer()
+    {
+        if (m_active)
+            DragStatisticsCollector::self()->addSample(m_phase, m_timer.nsecsElapsed());
+    }
+
+private:
+    Q_DISABLE_COPY(ScopedDragPhaseTimer)
+    const DragPhase m_phase;
+    const bool m_active;
+    QElapsedTimer m_timer;
+};
+
+}
+
+#endif
@@ -15,6 +15,7 @@
 #include "DockWidgetBase.h"
 #include "DockWidgetBase_p.h"
 #include "Draggable_p.h"
+#include "DragStatistics_p.h"
 #include "DropIndicatorOverlayInterface_p.h"
 #include "FloatingWindow_p.h"
 #include "Frame_p.h"
@@ -79,17 +80,16 @@ Frame::List DropArea::frames() const
 
 Frame *DropArea::frameContainingPos(QPoint globalPos) const
 {
-    const Layouting::Item::List &items = this->items();
-    for (Layouting::Item *item : items) {
+    // Called on every hover, so traverse the items instead of copying them
+    Frame *result = nullptr;
+    rootItem()->forEachLeaf([&result, globalPos](Layouting::Item *item) {
         auto frame = static_cast<Frame *>(item->guestAsQObject());
-        if (!frame || !frame->QWidgetAdapter::isVisible()) {
-            continue;
-        }
+        if (frame && frame->QWidgetAdapter::isVisible() && frame->containsMouse(globalPos))
+            result = frame;
+        return !result;
+    });
 
-        if (frame->containsMouse(globalPos))
-            return frame;
-    }
-    return nullptr;
+    return result;
 }
 
 void DropArea::updateFloatingActions()
@@ -101,13 +101,16 @@ void DropArea::updateFloatingActions()
 
 Layouting::Item *DropArea::centralFrame() const
 {
-    for (Layouting::Item *item : this->items()) {
+    Layouting::Item *result = nullptr;
+    rootItem()->forEachLeaf([&result](Layouting::Item *item) {
         if (auto f = static_cast<Frame *>(item->guestAsQObject())) {
             if (f->isCentralFrame())
-                return item;
+                result = item;
         }
-    }
-    return nullptr;
+        return !result;
+    });
+
+    return result;
 }
 
 void DropArea::addDockWidget(DockWidgetBase *dw, Location location,
@@ -203,6 +206,8 @@ void DropArea::layoutParentContainerEqually(DockWidgetBase *dw)
 
 DropLocation DropArea::hover(WindowBeingDragged *draggedWindow, QPoint globalPos)
 {
+    ScopedDragPhaseTimer timer(DragPhase::DropAreaHover);
+
     if (Config::self().dropIndicatorsInhibited() || !validateAffinity(draggedWindow))
         return DropLocation_None;
 
@@ -232,6 +237,8 @@ static bool isOutterLocation(DropLocation location)
 
 bool DropArea::drop(WindowBeingDragged *droppedWindow, QPoint globalPos)
 {
+    ScopedDragPhaseTimer timer(DragPhase::Drop);
+
     FloatingWindow *floatingWindow = droppedWindow->floatingWindow();
 
     if (floatingWindow == window()) {
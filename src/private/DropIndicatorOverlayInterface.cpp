@@ -15,6 +15,7 @@
 #include "DropArea_p.h"
 #include "DockRegistry_p.h"
 #include "DragController_p.h"
+#include "DragStatistics_p.h"
 #include "Config.h"
 
 using namespace KDDockWidgets;
@@ -194,6 +195,7 @@ void DropIndicatorOverlayInterface::setCurrentDropLocation(DropLocation location
 
 DropLocation DropIndicatorOverlayInterface::hover(QPoint globalPos)
 {
+    ScopedDragPhaseTimer timer(DragPhase::IndicatorsHover);
     return hover_impl(globalPos);
 }
 
@@ -32,6 +32,8 @@
 #include <QTimer>
 #include <QWindow>
 
+#include <algorithm>
+
 #if defined(Q_OS_WIN)
 #if defined(Q_CC_MSVC)
 // NOMINMAX tells windows.h not to define the max and min macros
@@ -47,6 +49,17 @@ using namespace KDDockWidgets;
 /** static */
 Qt::WindowFlags FloatingWindow::s_windowFlagsOverride = {};
 
+namespace {
+struct PooledFloatingWindow
+{
+    FloatingWindow *window;
+    QPointer<MainWindowBase> parent;
+};
+}
+
+static QVector<PooledFloatingWindow> s_windowPool; // Hidden windows, see Config::setFloatingWindowPoolSize()
+static bool s_poolReplenishScheduled = false;
+
 static Qt::WindowFlags windowFlagsToUse(FloatingWindowFlags requestedFlags)
 {
     if (requestedFlags & FloatingWindowFlag::UseQtTool) {
@@ -211,6 +224,11 @@ static FloatingWindowFlags floatingWindowFlagsForFrame(Frame *frame)
 
 FloatingWindow::FloatingWindow(Frame *frame, QRect suggestedGeometry, MainWindowBase *parent)
     : FloatingWindow(suggestedGeometry, hackFindParentHarder(frame, parent), floatingWindowFlagsForFrame(frame))
+{
+    addInitialFrame(frame);
+}
+
+void FloatingWindow::addInitialFrame(Frame *frame)
 {
     QScopedValueRollback<bool> guard(m_disableSetVisible, true);
 
@@ -266,9 +284,96 @@ FloatingWindow::~FloatingWindow()
     disconnect(m_layoutDestroyedConnection);
     delete m_nchittestFilter;
 
+    if (m_isPooled) {
+        auto it = std::find_if(s_windowPool.begin(), s_windowPool.end(), [this](const PooledFloatingWindow &pooled) {
+            return pooled.window == this;
+        });
+        if (it != s_windowPool.end())
+            s_windowPool.erase(it);
+    }
+
     DockRegistry::self()->unregisterFloatingWindow(this);
 }
 
+FloatingWindow *FloatingWindow::takePooledWindow(Frame *frame, QRect suggestedGeometry, MainWindowBase *parent)
+{
+    if (Config::self().floatingWindowPoolSize() <= 0)
+        return nullptr;
+
+    // Same parent and flags the constructor would use
+    parent = actualParent(hackFindParentHarder(frame, parent));
+    const FloatingWindowFlags flags = flagsForFloatingWindow(floatingWindowFlagsForFrame(frame));
+
+    auto it = std::find_if(s_windowPool.begin(), s_windowPool.end(), [parent, flags](const PooledFloatingWindow &pooled) {
+        return pooled.parent == parent && pooled.window->m_flags == flags;
+    });
+
+    if (it == s_windowPool.end()) {
+        qCDebug(creation) << Q_FUNC_INFO << "No pooled window for parent" << parent;
+        return nullptr;
+    }
+
+    FloatingWindow *window = it->window;
+    s_windowPool.erase(it);
+    window->m_isPooled = false;
+    DockRegistry::self()->registerFloatingWindow(window);
+
+    if (!suggestedGeometry.isNull())
+        window->setGeometry(suggestedGeometry);
+    window->addInitialFrame(frame);
+
+    updatePool();
+    return window;
+}
+
+void FloatingWindow::updatePool()
+{
+    const int poolSize = qMax(0, Config::self().floatingWindowPoolSize());
+    while (s_windowPool.size() > poolSize)
+        delete s_windowPool.takeLast().window;
+
+    if (s_windowPool.size() < poolSize && !s_poolReplenishScheduled) {
+        s_poolReplenishScheduled = true;
+        QTimer::singleShot(0, qApp, &FloatingWindow::replenishPool);
+    }
+}
+
+void FloatingWindow::clearPool()
+{
+    while (!s_windowPool.isEmpty())
+        delete s_windowPool.takeLast().window;
+}
+
+void FloatingWindow::replenishPool()
+{
+    s_poolReplenishScheduled = false;
+
+    // Nothing to float yet. Also, unregistering the pooled window below would delete an empty DockRegistry.
+    if (s_windowPool.size() >= Config::self().floatingWindowPoolSize() || DockRegistry::self()->isEmpty())
+        return;
+
+    // Pool windows for the main window that floating windows get parented to by default
+    MainWindowBase *parent = actualParent(hackFindParentHarder(nullptr, nullptr));
+    FloatingWindow *window = Config::self().frameworkWidgetFactory()->createFloatingWindow(parent);
+    DockRegistry::self()->unregisterFloatingWindow(window);
+    window->m_isPooled = true;
+
+    // The native window is what's expensive, create it now instead of when the user starts dragging
+    window->create();
+    if (QWindow *handle = window->windowHandle())
+        handle->create();
+
+    s_windowPool.push_back({ window, parent });
+
+    // One window per timer event, so we don't block the event loop for long
+    updatePool();
+}
+
+int FloatingWindow::dbg_numPooledWindows()
+{
+    return s_windowPool.size();
+}
+
 #if defined(Q_OS_WIN) && defined(KDDOCKWIDGETS_QTWIDGETS)
 bool FloatingWindow::nativeEvent(const QByteArray &eventType, void *message, Qt5Qt6Compat::qintptr *result)
 {
@@ -417,20 +522,25 @@ bool FloatingWindow::isInDragArea(QPoint globalPoint) const
 
 bool FloatingWindow::anyNonClosable() const
 {
-    for (Frame *frame : frames()) {
-        if (frame->anyNonClosable())
-            return true;
-    }
-    return false;
+    bool result = false;
+    m_dropArea->rootItem()->forEachLeaf([&result](Layouting::Item *item) {
+        if (auto frame = static_cast<Frame *>(item->guestAsQObject()))
+            result = frame->anyNonClosable();
+        return !result;
+    });
+    return result;
 }
 
 bool FloatingWindow::anyNonDockable() const
 {
-    for (Frame *frame : frames()) {
-        if (frame->anyNonDockable())
-            return true;
-    }
-    return false;
+    // Called on every mouse move while dragging, so traverse the items instead of copying them
+    bool result = false;
+    m_dropArea->rootItem()->forEachLeaf([&result](Layouting::Item *item) {
+        if (auto frame = static_cast<Frame *>(item->guestAsQObject()))
+            result = frame->anyNonDockable();
+        return !result;
+    });
+    return result;
 }
 
 bool FloatingWindow::hasSingleFrame() const
@@ -69,6 +69,20 @@ public:
 
     static void ensureRectIsOnScreen(QRect &geometry);
 
+    ///@brief Returns a pre-created window from the pool, with @p frame already added to it
+    /// Returns nullptr if the pool has no window with the flags and parent that @p frame needs.
+    /// Used by FrameworkWidgetFactory::createFloatingWindow(). See Config::setFloatingWindowPoolSize()
+    static FloatingWindow *takePooledWindow(Frame *frame, QRect suggestedGeometry, MainWindowBase *parent = nullptr);
+
+    ///@brief Deletes pooled windows above the pool size and schedules creating the missing ones
+    static void updatePool();
+
+    ///@brief Deletes all pooled windows. Called at shutdown, see DockRegistry
+    static void clearPool();
+
+    ///@brief For tests-only. Returns how many hidden windows are ready in the pool
+    static int dbg_numPooledWindows();
+
 #ifdef Q_OS_WIN
     void setLastHitTest(int hitTest)
     {
@@ -262,7 +276,15 @@ private:
     void updateSizeConstraints();
     void onFrameCountChanged(int count);
     void onVisibleFrameCountChanged(int count);
+
+    /// @brief Adds the frame being floated. Called at construction or when taking a window from the pool.
+    void addInitialFrame(Frame *frame);
+
+    /// @brief Creates one pooled window, if still needed. Runs from a timer so it's done when the app is idle.
+    static void replenishPool();
+
     bool m_disableSetVisible = false;
+    bool m_isPooled = false;
     bool m_deleteScheduled = false;
     bool m_inDtor = false;
     bool m_updatingTitleBarVisibility = false;
@@ -40,6 +40,9 @@
 #define MARGIN_THRESHOLD 100
 
 static int s_dbg_numFrames = 0;
+static int s_framePoolHits = 0;
+static int s_framePoolMisses = 0;
+static QVector<KDDockWidgets::Frame *> s_framePool; // Empty frames kept for reuse, see Config::setFramePoolSize()
 
 using namespace KDDockWidgets;
 
@@ -86,7 +89,11 @@ Frame::Frame(QWidgetOrQuick *parent, FrameOptions options, int userType)
 Frame::~Frame()
 {
     m_inDtor = true;
-    s_dbg_numFrames--;
+    if (m_isPooled)
+        s_framePool.removeOne(this);
+    else
+        s_dbg_numFrames--;
+
     if (m_layoutItem)
         m_layoutItem->unref();
 
@@ -194,6 +201,7 @@ void Frame::insertWidget(DockWidgetBase *dockWidget, int index, InitialOption ad
 
 void Frame::removeWidget(DockWidgetBase *dw)
 {
+    m_recentTabs.removeOne(dw);
     disconnect(dw, &DockWidgetBase::titleChanged, this, &Frame::onDockWidgetTitleChanged);
     disconnect(dw, &DockWidgetBase::iconChanged, this, &Frame::onDockWidgetTitleChanged);
     removeWidget_impl(dw);
@@ -311,6 +319,11 @@ void Frame::onCurrentTabChanged(int index)
 {
     if (index != -1) {
         if (auto dock = dockWidgetAt(index)) {
+            dock->d->wakeUp();
+            m_recentTabs.removeOne(dock);
+            m_recentTabs.push_back(dock);
+            releaseInactiveTabGuests();
+
             Q_EMIT currentDockWidgetChanged(dock);
         } else {
             qWarning() << "dockWidgetAt" << index << "returned nullptr" << this;
@@ -318,6 +331,45 @@ void Frame::onCurrentTabChanged(int index)
     }
 }
 
+void Frame::releaseInactiveTabGuests()
+{
+    const int maxLiveGuests = Config::self().maxLiveTabGuests();
+    if (maxLiveGuests < 1)
+        return;
+
+    const DockWidgetBase::List docks = dockWidgets();
+    if (docks.size() <= maxLiveGuests)
+        return;
+
+    // Tabs which were never current are the least recent ones
+    DockWidgetBase::List byRecency;
+    byRecency.reserve(docks.size());
+    for (DockWidgetBase *dw : docks) {
+        if (!m_recentTabs.contains(dw))
+            byRecency.push_back(dw);
+    }
+
+    for (DockWidgetBase *dw : qAsConst(m_recentTabs)) {
+        if (docks.contains(dw))
+            byRecency.push_back(dw);
+    }
+
+    int numLiveGuests = 0;
+    for (DockWidgetBase *dw : qAsConst(byRecency)) {
+        if (!dw->isHibernated())
+            numLiveGuests++;
+    }
+
+    DockWidgetBase *current = currentDockWidget();
+    for (DockWidgetBase *dw : qAsConst(byRecency)) {
+        if (numLiveGuests <= maxLiveGuests)
+            break;
+
+        if (dw != current && !dw->isHibernated() && dw->d->hibernate())
+            numLiveGuests--;
+    }
+}
+
 void Frame::isFocusedChangedCallback()
 {
     Q_EMIT isFocusedChanged();
@@ -416,10 +468,10 @@ const DockWidgetBase::List Frame::dockWidgets() const
         return {};
 
     DockWidgetBase::List dockWidgets;
-    const int count = dockWidgetCount();
-    dockWidgets.reserve(count);
-    for (int i = 0; i < count; ++i)
-        dockWidgets << dockWidgetAt(i);
+    dockWidgets.reserve(dockWidgetCount());
+    forEachDockWidget([&dockWidgets](DockWidgetBase *dw) {
+        dockWidgets << dw;
+    });
 
     return dockWidgets;
 }
@@ -499,22 +551,25 @@ void Frame::onCloseEvent(QCloseEvent *e)
 
 bool Frame::anyNonClosable() const
 {
-    for (auto dw : dockWidgets()) {
-        if ((dw->options() & DockWidgetBase::Option_NotClosable) && !DockRegistry::self()->isProcessingAppQuitEvent())
-            return true;
-    }
+    if (DockRegistry::self()->isProcessingAppQuitEvent())
+        return false;
 
-    return false;
+    bool result = false;
+    forEachDockWidget([&result](DockWidgetBase *dw) {
+        result = result || (dw->options() & DockWidgetBase::Option_NotClosable);
+    });
+
+    return result;
 }
 
 bool Frame::anyNonDockable() const
 {
-    for (auto dw : dockWidgets()) {
-        if (dw->options() & DockWidgetBase::Option_NotDockable)
-            return true;
-    }
+    bool result = false;
+    forEachDockWidget([&result](DockWidgetBase *dw) {
+        result = result || (dw->options() & DockWidgetBase::Option_NotDockable);
+    });
 
-    return false;
+    return result;
 }
 
 void Frame::onDockWidgetShown(DockWidgetBase *w)
@@ -554,11 +609,13 @@ void Frame::setLayoutItem(Layouting::Item *item)
 
     m_layoutItem = item;
     if (item) {
-        for (DockWidgetBase *dw : dockWidgets())
+        forEachDockWidget([item](DockWidgetBase *dw) {
             dw->d->addPlaceholderItem(item);
+        });
     } else {
-        for (DockWidgetBase *dw : dockWidgets())
+        forEachDockWidget([](DockWidgetBase *dw) {
             dw->d->lastPosition()->removePlaceholders();
+        });
     }
 }
 
@@ -572,6 +629,84 @@ int Frame::dbg_numFrames()
     return s_dbg_numFrames;
 }
 
+Frame *Frame::takeRecycledFrame(QWidgetOrQuick *parent, FrameOptions options)
+{
+    if (Config::self().framePoolSize() <= 0)
+        return nullptr;
+
+    options = actualOptions(options);
+    for (int i = s_framePool.size() - 1; i >= 0; --i) {
+        Frame *frame = s_framePool.at(i);
+        if (frame->m_options != options)
+            continue;
+
+        s_framePool.removeAt(i);
+        s_framePoolHits++;
+        s_dbg_numFrames++;
+        frame->m_isPooled = false;
+        frame->m_beingDeleted = false;
+        DockRegistry::self()->registerFrame(frame);
+
+        frame->QWidgetAdapter::setParent(parent);
+        frame->setLayoutWidget(qobject_cast<LayoutWidget *>(parent));
+        return frame;
+    }
+
+    s_framePoolMisses++;
+    return nullptr;
+}
+
+void Frame::trimFramePool(int maxSize)
+{
+    while (s_framePool.size() > qMax(0, maxSize))
+        delete s_framePool.takeLast();
+}
+
+int Frame::dbg_numPooledFrames()
+{
+    return s_framePool.size();
+}
+
+int Frame::dbg_framePoolHits()
+{
+    return s_framePoolHits;
+}
+
+int Frame::dbg_framePoolMisses()
+{
+    return s_framePoolMisses;
+}
+
+bool Frame::recycle()
+{
+    if (s_framePool.size() >= Config::self().framePoolSize())
+        return false;
+
+    // Central and overlayed frames are special, and frames with a user type were created by the user, not by the factory
+    if (!isEmpty() || isCentralFrame() || isOverlayed() || m_userType != 0)
+        return false;
+
+    qCDebug(creation) << Q_FUNC_INFO << this;
+
+    // Changing the parent makes the layout item turn into a placeholder, dropping the ref makes it go away
+    QWidgetAdapter::setParent(nullptr);
+    setLayoutItem(nullptr);
+    setLayoutWidget(nullptr);
+
+    m_titleBar->setTitle(QString());
+    m_titleBar->setIcon(QIcon());
+    setObjectName(QString());
+
+    DockRegistry::self()->unregisterFrame(this);
+    s_dbg_numFrames--;
+    m_isPooled = true;
+
+    Config::self().frameworkWidgetFactory()->resetFrame(this);
+    s_framePool.push_back(this);
+
+    return true;
+}
+
 bool Frame::beingDeletedLater() const
 {
     return m_beingDeleted;
@@ -751,15 +886,17 @@ void Frame::scheduleDeleteLater()
     m_beingDeleted = true;
     QTimer::singleShot(0, this, [this] {
         // Can't use deleteLater() here due to QTBUG-83030 (deleteLater() never delivered if triggered by a sendEvent() before event loop starts)
-        delete this;
+        if (!recycle())
+            delete this;
     });
 }
 
 QSize Frame::dockWidgetsMinSize() const
 {
     QSize size = Layouting::Item::hardcodedMinimumSize;
-    for (DockWidgetBase *dw : dockWidgets())
+    forEachDockWidget([&size](DockWidgetBase *dw) {
         size = size.expandedTo(Layouting::Widget::widgetMinSize(dw));
+    });
 
     return size;
 }
@@ -767,17 +904,17 @@ QSize Frame::dockWidgetsMinSize() const
 QSize Frame::biggestDockWidgetMaxSize() const
 {
     QSize size = Layouting::Item::hardcodedMaximumSize;
-    for (DockWidgetBase *dw : dockWidgets()) {
-        const QSize dwMax = widgetMaxSize(dw);
+    forEachDockWidget([&size](DockWidgetBase *dw) {
+        const QSize dwMax = Layouting::Widget::widgetMaxSize(dw);
         if (size == Layouting::Item::hardcodedMaximumSize) {
             size = dwMax;
-            continue;
+            return;
         }
 
         const bool hasMaxSize = dwMax != Layouting::Item::hardcodedMaximumSize;
         if (hasMaxSize)
             size = dw->maximumSize().expandedTo(size);
-    }
+    });
 
     // Interpret 0 max-size as not having one too.
     if (size.width() == 0)
@@ -112,6 +112,19 @@ public:
     /// @brief returns the number of dock widgets inside the frame
     int dockWidgetCount() const;
 
+    /// @brief Calls @p func for each dock widget, in tab order
+    /// Unlike dockWidgets() it doesn't allocate a list.
+    template <typename Func>
+    void forEachDockWidget(Func &&func) const
+    {
+        if (m_inCtor || m_inDtor)
+            return;
+
+        const int count = dockWidgetCount();
+        for (int i = 0; i < count; ++i)
+            func(dockWidgetAt(i));
+    }
+
     /// @brief returns the tab widget
     TabWidget *tabWidget() const;
 
@@ -241,6 +254,23 @@ public:
     ///@brief For tests-only. Returns the number of Frame instances in the whole application.
     static int dbg_numFrames();
 
+    ///@brief Returns an empty frame from the recycling pool, reparented into @p parent
+    /// Returns nullptr if the pool doesn't have a frame with the same @p options.
+    /// See Config::setFramePoolSize()
+    static Frame *takeRecycledFrame(QWidgetOrQuick *parent, FrameOptions options);
+
+    ///@brief Deletes pooled frames until there's at most @p maxSize of them left
+    static void trimFramePool(int maxSize);
+
+    ///@brief For tests-only. Returns how many frames are currently kept in the recycling pool.
+    static int dbg_numPooledFrames();
+
+    ///@brief For tests-only. Returns how many takeRecycledFrame() calls were served by the pool.
+    static int dbg_framePoolHits();
+
+    ///@brief For tests-only. Returns how many takeRecycledFrame() calls found no suitable frame.
+    static int dbg_framePoolMisses();
+
     /**
      * @brief Returns whether a deleteLater has already been issued
      */
@@ -384,17 +414,26 @@ private:
     void scheduleDeleteLater();
     bool event(QEvent *) override;
 
+    /// @brief Detaches this empty frame from its layout and puts it in the recycling pool
+    /// Returns false if the pool is full or the frame can't be reused, in which case it should be deleted.
+    bool recycle();
+
     /// @brief Sets the LayoutWidget which this frame is in
     void setLayoutWidget(LayoutWidget *);
 
+    /// @brief Hibernates the guests of the least recently current tabs, while over Config::maxLiveTabGuests()
+    void releaseInactiveTabGuests();
+
     LayoutWidget *m_layoutWidget = nullptr;
     WidgetResizeHandler *m_resizeHandler = nullptr;
     FrameOptions m_options = FrameOption_None;
     QPointer<Layouting::Item> m_layoutItem;
     bool m_updatingTitleBar = false;
     bool m_beingDeleted = false;
+    bool m_isPooled = false;
     int m_userType = 0;
     QMetaObject::Connection m_visibleWidgetCountChangedConnection;
+    QVector<DockWidgetBase *> m_recentTabs; // Least recently current first
 };
 
 }
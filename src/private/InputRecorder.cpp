@@ -0,0 +1,353 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "InputRecorder_p.h"
+#include "DockRegistry_p.h"
+#include "DragStatistics_p.h"
+#include "FloatingWindow_p.h"
+#include "LayoutSaver.h"
+#include "Qt5Qt6Compat_p.h"
+#include "Utils_p.h"
+
+#include <QCursor>
+#include <QDebug>
+#include <QFile>
+#include <QGuiApplication>
+#include <QJsonDocument>
+#include <QMouseEvent>
+#include <QWindow>
+
+using namespace KDDockWidgets;
+
+static const int s_recordingSerializationVersion = 1;
+
+static QStringList sortedDockNames(const DockWidgetBase::List &docks)
+{
+    QStringList names;
+    names.reserve(docks.size());
+    for (DockWidgetBase *dw : docks)
+        names.push_back(dw->uniqueName());
+
+    names.sort();
+    return names;
+}
+
+static QVariantMap eventToVariantMap(const RecordedInputEvent &ev)
+{
+    QVariantMap map;
+    map.insert(QStringLiteral("type"), int(ev.type));
+    map.insert(QStringLiteral("timestampNs"), ev.timestampNs);
+    map.insert(QStringLiteral("windowId"), ev.windowId);
+    map.insert(QStringLiteral("x"), ev.globalPos.x());
+    map.insert(QStringLiteral("y"), ev.globalPos.y());
+    map.insert(QStringLiteral("button"), int(ev.button));
+    map.insert(QStringLiteral("buttons"), int(ev.buttons));
+    map.insert(QStringLiteral("modifiers"), int(ev.modifiers));
+    return map;
+}
+
+static RecordedInputEvent eventFromVariantMap(const QVariantMap &map)
+{
+    RecordedInputEvent ev;
+    ev.type = QEvent::Type(map.value(QStringLiteral("type")).toInt());
+    ev.timestampNs = map.value(QStringLiteral("timestampNs")).toLongLong();
+    ev.windowId = map.value(QStringLiteral("windowId")).toString();
+    ev.globalPos = QPoint(map.value(QStringLiteral("x")).toInt(), map.value(QStringLiteral("y")).toInt());
+    ev.button = Qt::MouseButton(map.value(QStringLiteral("button")).toInt());
+    ev.buttons = Qt::MouseButtons(map.value(QStringLiteral("buttons")).toInt());
+    ev.modifiers = Qt::KeyboardModifiers(map.value(QStringLiteral("modifiers")).toInt());
+    return ev;
+}
+
+InputRecorder::InputRecorder(QObject *parent)
+    : QObject(parent)
+{
+}
+
+InputRecorder::~InputRecorder()
+{
+    if (m_isRecording)
+        qApp->removeEventFilter(this);
+}
+
+void InputRecorder::startRecording()
+{
+    if (m_isRecording) {
+        qWarning() << Q_FUNC_INFO << "Already recording";
+        return;
+    }
+
+    LayoutSaver saver;
+    m_initialLayout = saver.serializeLayout();
+    m_events.clear();
+    m_isRecording = true;
+    m_timer.start();
+    qApp->installEventFilter(this);
+}
+
+QByteArray InputRecorder::stopRecording()
+{
+    if (!m_isRecording) {
+        qWarning() << Q_FUNC_INFO << "Not recording";
+        return {};
+    }
+
+    qApp->removeEventFilter(this);
+    m_isRecording = false;
+
+    QVariantList events;
+    events.reserve(m_events.size());
+    for (const RecordedInputEvent &ev : qAsConst(m_events))
+        events.push_back(eventToVariantMap(ev));
+
+    QVariantMap map;
+    map.insert(QStringLiteral("serializationVersion"), s_recordingSerializationVersion);
+    map.insert(QStringLiteral("layout"), QJsonDocument::fromJson(m_initialLayout).toVariant());
+    map.insert(QStringLiteral("events"), events);
+
+    return QJsonDocument::fromVariant(map).toJson();
+}
+
+bool InputRecorder::stopRecording(const QString &filename)
+{
+    const QByteArray data = stopRecording();
+    if (data.isEmpty())
+        return false;
+
+    QFile f(filename);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << filename << f.errorString();
+        return false;
+    }
+
+    f.write(data);
+    return true;
+}
+
+bool InputRecorder::isRecording() const
+{
+    return m_isRecording;
+}
+
+QVector<RecordedInputEvent> InputRecorder::events() const
+{
+    return m_events;
+}
+
+QString InputRecorder::windowId(QWindow *window)
+{
+    if (!window)
+        return {};
+
+    DockRegistry *dr = DockRegistry::self();
+    const MainWindowBase::List mainWindows = dr->mainwindows();
+    for (MainWindowBase *mw : mainWindows) {
+        // Not using mainWindowForHandle(), as the main window might be embedded
+        if (KDDockWidgets::Private::windowForWidget(mw) == window)
+            return QStringLiteral("mainwindow:") + mw->uniqueName();
+    }
+
+    if (FloatingWindow *fw = dr->floatingWindowForHandle(window))
+        return QStringLiteral("floatingwindow:") + sortedDockNames(fw->dockWidgets()).join(QLatin1Char(','));
+
+    const DockWidgetBase::List docks = dr->dockwidgets();
+    for (DockWidgetBase *dw : docks) {
+        if (dw->isWindow() && dw->windowHandle() == window)
+            return QStringLiteral("dockwidget:") + dw->uniqueName();
+    }
+
+    return {};
+}
+
+QWindow *InputRecorder::windowForId(const QString &id)
+{
+    DockRegistry *dr = DockRegistry::self();
+    const int separatorIndex = id.indexOf(QLatin1Char(':'));
+    const QString kind = id.left(separatorIndex);
+    const QString name = id.mid(separatorIndex + 1);
+
+    if (kind == QLatin1String("mainwindow")) {
+        if (MainWindowBase *mw = dr->mainWindowByName(name))
+            return KDDockWidgets::Private::windowForWidget(mw);
+    } else if (kind == QLatin1String("floatingwindow")) {
+        const QStringList names = name.split(QLatin1Char(','));
+        const QVector<FloatingWindow *> floatingWindows = dr->floatingWindows();
+        for (FloatingWindow *fw : floatingWindows) {
+            if (sortedDockNames(fw->dockWidgets()) == names)
+                return fw->windowHandle();
+        }
+    } else if (kind == QLatin1String("dockwidget")) {
+        if (DockWidgetBase *dw = dr->dockByName(name))
+            return dw->windowHandle();
+    }
+
+    return nullptr;
+}
+
+bool InputRecorder::isRecordableEvent(QEvent::Type type)
+{
+    switch (type) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    case QEvent::NonClientAreaMouseButtonPress:
+    case QEvent::NonClientAreaMouseButtonRelease:
+    case QEvent::NonClientAreaMouseButtonDblClick:
+    case QEvent::NonClientAreaMouseMove:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool InputRecorder::eventFilter(QObject *o, QEvent *e)
+{
+    // Only record at QWindow level. The same event is then delivered to widgets/items, but that
+    // will happen again while replaying, with the same grabbing rules.
+    if (!isRecordableEvent(e->type()))
+        return false;
+
+    auto window = qobject_cast<QWindow *>(o);
+    if (!window)
+        return false;
+
+    const QString id = windowId(window);
+    if (id.isEmpty())
+        return false;
+
+    auto me = static_cast<QMouseEvent *>(e);
+
+    RecordedInputEvent ev;
+    ev.type = e->type();
+    ev.timestampNs = m_timer.nsecsElapsed();
+    ev.windowId = id;
+    ev.globalPos = Qt5Qt6Compat::eventGlobalPos(me);
+    ev.button = me->button();
+    ev.buttons = me->buttons();
+    ev.modifiers = me->modifiers();
+    m_events.push_back(ev);
+
+    return false;
+}
+
+InputReplayer::InputReplayer() = default;
+InputReplayer::~InputReplayer() = default;
+
+bool InputReplayer::load(const QByteArray &recording)
+{
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(recording, &error);
+    if (error.error != QJsonParseError::NoError) {
+        qWarning() << Q_FUNC_INFO << "Invalid recording" << error.errorString();
+        return false;
+    }
+
+    const QVariantMap map = doc.toVariant().toMap();
+    const int serializationVersion = map.value(QStringLiteral("serializationVersion")).toInt();
+    if (serializationVersion != s_recordingSerializationVersion) {
+        qWarning() << Q_FUNC_INFO << "Unsupported recording version" << serializationVersion;
+        return false;
+    }
+
+    m_initialLayout = QJsonDocument::fromVariant(map.value(QStringLiteral("layout"))).toJson();
+
+    const QVariantList events = map.value(QStringLiteral("events")).toList();
+    m_events.clear();
+    m_events.reserve(events.size());
+    for (const QVariant &ev : events)
+        m_events.push_back(eventFromVariantMap(ev.toMap()));
+
+    return true;
+}
+
+bool InputReplayer::loadFromFile(const QString &filename)
+{
+    QFile f(filename);
+    if (!f.open(QIODevice::ReadOnly)) {
+        qWarning() << Q_FUNC_INFO << "Failed to open" << filename << f.errorString();
+        return false;
+    }
+
+    return load(f.readAll());
+}
+
+bool InputReplayer::restoreInitialLayout()
+{
+    LayoutSaver restorer;
+    return restorer.restoreLayout(m_initialLayout);
+}
+
+InputReplayer::Result InputReplayer::replay(bool honourTimestamps)
+{
+    Result result;
+    QVector<qint64> pressSamples;
+    QVector<qint64> moveSamples;
+    QVector<qint64> releaseSamples;
+
+    QElapsedTimer replayTimer;
+    replayTimer.start();
+    QElapsedTimer dispatchTimer;
+
+    for (const RecordedInputEvent &ev : qAsConst(m_events)) {
+        if (honourTimestamps) {
+            while (replayTimer.nsecsElapsed() < ev.timestampNs)
+                qApp->processEvents(QEventLoop::AllEvents, 1);
+        }
+
+        // Resolved per event, as windows are created and destroyed while docking
+        QWindow *window = InputRecorder::windowForId(ev.windowId);
+        if (!window) {
+            qWarning() << Q_FUNC_INFO << "Could not find window" << ev.windowId;
+            result.numSkippedEvents++;
+            continue;
+        }
+
+        QCursor::setPos(ev.globalPos); // Since some code uses QCursor::pos()
+        const QPointF localPos = window->mapFromGlobal(ev.globalPos);
+        QMouseEvent me(ev.type, localPos, localPos, ev.globalPos, ev.button, ev.buttons, ev.modifiers);
+
+        dispatchTimer.start();
+        qApp->sendEvent(window, &me);
+        const qint64 elapsed = dispatchTimer.nsecsElapsed();
+
+        switch (ev.type) {
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonDblClick:
+        case QEvent::NonClientAreaMouseButtonPress:
+        case QEvent::NonClientAreaMouseButtonDblClick:
+            pressSamples.push_back(elapsed);
+            break;
+        case QEvent::MouseMove:
+        case QEvent::NonClientAreaMouseMove:
+            moveSamples.push_back(elapsed);
+            break;
+        default:
+            releaseSamples.push_back(elapsed);
+            break;
+        }
+
+        result.numEvents++;
+        qApp->processEvents();
+    }
+
+    result.totalNs = replayTimer.nsecsElapsed();
+    result.pressTimings = DragStatisticsCollector::summarize(pressSamples);
+    result.moveTimings = DragStatisticsCollector::summarize(moveSamples);
+    result.releaseTimings = DragStatisticsCollector::summarize(releaseSamples);
+
+    return result;
+}
+
+QVector<RecordedInputEvent> InputReplayer::events() const
+{
+    return m_events;
+}
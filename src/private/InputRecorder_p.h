@@ -0,0 +1,135 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_INPUTRECORDER_P_H
+#define KD_INPUTRECORDER_P_H
+
+#include "kddockwidgets/KDDockWidgets.h"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QObject>
+#include <QPoint>
+#include <QStringList>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QWindow;
+QT_END_NAMESPACE
+
+/**
+ * @file
+ * @brief Records the mouse input received by our top-levels, so it can be replayed deterministically.
+ *
+ * A recording contains the layout at the time the recording started (as saved by LayoutSaver) and
+ * the mouse press, move, release and double-click events delivered to our windows. Windows are
+ * identified by the unique names of MainWindows and DockWidgets, so they can be found again after
+ * the layout is restored.
+ *
+ * Events are recorded at QWindow level, that's where DragController and WidgetResizeHandler input
+ * originates from, and replaying them there goes through Qt's regular mouse grabbing and routing.
+ *
+ * @author Sérgio Martins \<sergio.martins@kdab.com\>
+ */
+
+namespace KDDockWidgets {
+
+/// @brief A mouse event as stored in a recording
+struct RecordedInputEvent
+{
+    QEvent::Type type = QEvent::None;
+    qint64 timestampNs = 0; ///< Relative to the start of the recording
+    QString windowId; ///< See InputRecorder::windowId()
+    QPoint globalPos;
+    Qt::MouseButton button = Qt::NoButton;
+    Qt::MouseButtons buttons = Qt::NoButton;
+    Qt::KeyboardModifiers modifiers = Qt::NoModifier;
+};
+
+class DOCKS_EXPORT InputRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit InputRecorder(QObject *parent = nullptr);
+    ~InputRecorder() override;
+
+    /// @brief Saves the current layout and starts recording mouse input
+    void startRecording();
+
+    /// @brief Stops recording and returns the recording as JSON
+    QByteArray stopRecording();
+
+    /// @overload Saves the recording to @p filename
+    bool stopRecording(const QString &filename);
+
+    bool isRecording() const;
+
+    /// @brief Returns the events recorded so far
+    QVector<RecordedInputEvent> events() const;
+
+    /// @brief Returns an id for the top-level @p window, based on the unique names it hosts
+    /// Returns an empty string if the window doesn't belong to KDDW.
+    static QString windowId(QWindow *window);
+
+    /// @brief Returns the window with the specified id. The counter-part of windowId()
+    static QWindow *windowForId(const QString &id);
+
+    static bool isRecordableEvent(QEvent::Type);
+
+protected:
+    bool eventFilter(QObject *, QEvent *) override;
+
+private:
+    QElapsedTimer m_timer;
+    QByteArray m_initialLayout;
+    QVector<RecordedInputEvent> m_events;
+    bool m_isRecording = false;
+};
+
+class DOCKS_EXPORT InputReplayer
+{
+public:
+    /// @brief Timings gathered while replaying
+    struct Result
+    {
+        int numEvents = 0; ///< Number of events replayed
+        int numSkippedEvents = 0; ///< Events whose window couldn't be found
+        qint64 totalNs = 0; ///< Wall time of the whole replay
+        DragPhaseStatistics pressTimings; ///< Time spent dispatching press and double-click events
+        DragPhaseStatistics moveTimings; ///< Time spent dispatching move events
+        DragPhaseStatistics releaseTimings; ///< Time spent dispatching release events
+    };
+
+    InputReplayer();
+    ~InputReplayer();
+
+    bool load(const QByteArray &recording);
+    bool loadFromFile(const QString &filename);
+
+    /// @brief Restores the layout which was saved when the recording started
+    bool restoreInitialLayout();
+
+    /// @brief Replays all events
+    /// @param honourTimestamps If true, the original pace is kept, otherwise events are sent as fast as possible
+    Result replay(bool honourTimestamps = false);
+
+    QVector<RecordedInputEvent> events() const;
+
+private:
+    Q_DISABLE_COPY(InputReplayer)
+    QByteArray m_initialLayout;
+    QVector<RecordedInputEvent> m_events;
+};
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include <QJsonDocument>
 #include <QRect>
 #include <QScreen>
+#include <QSet>
 #include <QSettings>
 
 #include <memory>
@@ -374,11 +375,32 @@ public:
         Q_DISABLE_COPY(RAIIIsRestoring)
     };
 
+    ///@brief The parts of the current layout which a partial restore rebuilds. Anything else is kept as is.
+    struct Scope
+    {
+        QStringList mainWindows; ///< Main windows whose layout is rebuilt
+        QStringList dockWidgets; ///< Dock widgets which are closed, then restored to where the layout puts them
+        QStringList lastPositions; ///< Dock widgets whose last position is restored, in addition to the above
+        QHash<int, int> keptFloatingWindows; ///< Index in Layout::floatingWindows -> index in DockRegistry::floatingWindows()
+        QSet<int> movedFloatingWindows; ///< Kept floating windows which only need their geometry restored
+    };
+
     explicit Private(RestoreOptions options);
 
     bool matchesAffinity(const QStringList &affinities) const;
+
+    ///@brief Fills @p layout with the current state, without encoding it. Returns false if the layout isn't sane.
+    bool serialize(LayoutSaver::Layout &layout);
+
+    /**
+     * @brief Applies @p layout, which was either parsed from JSON or filled by serialize()
+     *
+     * If @p scope is passed only the parts it lists are restored, it must have been computed
+     * against the current layout.
+     */
+    bool restore(LayoutSaver::Layout &layout, const Scope *scope = nullptr);
     void floatWidgetsWhichSkipRestore(const QStringList &mainWindowNames);
-    void floatUnknownWidgets(const LayoutSaver::Layout &layout);
+    void floatUnknownWidgets(const LayoutSaver::Layout &layout, const QStringList &mainWindowNames);
 
     template<typename T>
     void deserializeWindowGeometry(const T &saved, QWidgetOrQuick *topLevel);
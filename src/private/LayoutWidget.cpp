@@ -21,8 +21,13 @@
 
 #include "multisplitter/Item_p.h"
 
+#include <QMetaMethod>
+#include <QTimer>
+
 using namespace KDDockWidgets;
 
+// How long the main window needs to stay the same size before we lay it out, with Flag_LazyMainWindowResize
+static const int s_lazyMainWindowResizeDelay = 100;
 
 LayoutWidget::LayoutWidget(QWidgetOrQuick *parent)
     : LayoutGuestWidget(parent)
@@ -78,6 +83,103 @@ void LayoutWidget::setRootItem(Layouting::ItemContainer *root)
             &MultiSplitter::visibleWidgetCountChanged);
     connect(m_rootItem, &Layouting::ItemContainer::minSizeChanged, this,
             [this] { setMinimumSize(layoutMinimumSize()); });
+
+    connect(m_rootItem, &Layouting::ItemContainer::numItemsChanged, this,
+            &LayoutWidget::scheduleLayoutChanged);
+    connect(m_rootItem, &Layouting::ItemContainer::numVisibleItemsChanged, this,
+            &LayoutWidget::scheduleLayoutChanged);
+    m_descendantGeometryConnection = {};
+    updateDescendantGeometryTracking();
+    scheduleLayoutChanged();
+}
+
+void LayoutWidget::connectNotify(const QMetaMethod &signal)
+{
+    QWidgetAdapter::connectNotify(signal);
+    if (signal == QMetaMethod::fromSignal(&LayoutWidget::layoutChanged))
+        updateDescendantGeometryTracking();
+}
+
+void LayoutWidget::disconnectNotify(const QMetaMethod &signal)
+{
+    QWidgetAdapter::disconnectNotify(signal);
+    if (signal.isValid() && signal == QMetaMethod::fromSignal(&LayoutWidget::layoutChanged))
+        updateDescendantGeometryTracking();
+}
+
+void LayoutWidget::updateDescendantGeometryTracking()
+{
+    // Items change geometry very often, only listen while someone is mirroring this layout
+    static const QMetaMethod signal = QMetaMethod::fromSignal(&LayoutWidget::layoutChanged);
+    const bool track = m_rootItem && isSignalConnected(signal);
+    if (track == bool(m_descendantGeometryConnection))
+        return;
+
+    if (track) {
+        m_descendantGeometryConnection = connect(m_rootItem, &Layouting::ItemContainer::descendantGeometryChanged,
+                                                 this, &LayoutWidget::scheduleLayoutChanged);
+    } else {
+        disconnect(m_descendantGeometryConnection);
+        m_descendantGeometryConnection = {};
+    }
+}
+
+void LayoutWidget::scheduleLayoutChanged()
+{
+    if (m_layoutChangedScheduled)
+        return;
+
+    // Nobody is mirroring this layout, don't pay for the diff
+    static const QMetaMethod signal = QMetaMethod::fromSignal(&LayoutWidget::layoutChanged);
+    if (!isSignalConnected(signal)) {
+        // disconnectNotify() isn't called when the receiver is destroyed
+        updateDescendantGeometryTracking();
+        return;
+    }
+
+    m_layoutChangedScheduled = true;
+    QTimer::singleShot(0, this, &LayoutWidget::emitLayoutChanged);
+}
+
+void LayoutWidget::emitLayoutChanged()
+{
+    m_layoutChangedScheduled = false;
+
+    LayoutChanges changes;
+    QHash<const Layouting::Item *, TrackedItem> previous = std::move(m_trackedItems);
+    m_trackedItems.clear();
+
+    m_trackedItems.reserve(previous.size());
+    m_rootItem->forEachLeaf([&](const Layouting::Item *item) {
+        const TrackedItem current = { item, item->mapToRoot(item->rect()), item->isVisible() };
+        const LayoutChanges::ItemState state = { item, current.geometry, current.isVisible };
+        m_trackedItems.insert(item, current);
+
+        auto it = previous.find(item);
+        if (it == previous.end()) {
+            changes.added.push_back(state);
+        } else if (!it->item) {
+            // The tracked item was deleted and this new one got its address
+            changes.removed.push_back(item);
+            changes.added.push_back(state);
+        } else {
+            if (it->geometry != current.geometry)
+                changes.geometryChanged.push_back(state);
+            if (it->isVisible != current.isVisible)
+                changes.visibilityChanged.push_back(state);
+        }
+
+        if (it != previous.end())
+            previous.erase(it);
+
+        return true;
+    });
+
+    for (auto it = previous.cbegin(), end = previous.cend(); it != end; ++it)
+        changes.removed.push_back(it.key());
+
+    if (!changes.isEmpty())
+        Q_EMIT layoutChanged(changes);
 }
 
 QSize LayoutWidget::layoutMinimumSize() const
@@ -93,6 +195,8 @@ QSize LayoutWidget::layoutMaximumSizeHint() const
 void LayoutWidget::setLayoutMinimumSize(QSize sz)
 {
     if (sz != m_rootItem->minSize()) {
+        // Our size is stale while a resize is deferred, catch up first or we'd shrink back the window
+        applyPendingResize();
         setLayoutSize(size().expandedTo(m_rootItem->minSize())); // Increase size in case we need to
         m_rootItem->setMinSize(sz);
     }
@@ -196,9 +300,15 @@ Layouting::Item *LayoutWidget::itemForFrame(const Frame *frame) const
 DockWidgetBase::List LayoutWidget::dockWidgets() const
 {
     DockWidgetBase::List dockWidgets;
-    const Frame::List frames = this->frames();
-    for (Frame *frame : frames)
-        dockWidgets << frame->dockWidgets();
+    m_rootItem->forEachLeaf([&dockWidgets](Layouting::Item *item) {
+        if (auto frame = static_cast<Frame *>(item->guestAsQObject())) {
+            frame->forEachDockWidget([&dockWidgets](DockWidgetBase *dw) {
+                dockWidgets.push_back(dw);
+            });
+        }
+
+        return true;
+    });
 
     return dockWidgets;
 }
@@ -216,15 +326,12 @@ Frame::List LayoutWidget::framesFrom(QWidgetOrQuick *frameOrMultiSplitter) const
 
 Frame::List LayoutWidget::frames() const
 {
-    const Layouting::Item::List items = m_rootItem->items_recursive();
-
     Frame::List result;
-    result.reserve(items.size());
-
-    for (Layouting::Item *item : items) {
+    m_rootItem->forEachLeaf([&result](Layouting::Item *item) {
         if (auto f = static_cast<Frame *>(item->guestAsQObject()))
             result.push_back(f);
-    }
+        return true;
+    });
 
     return result;
 }
@@ -281,24 +388,60 @@ bool LayoutWidget::onResize(QSize newSize)
 
     if (!LayoutSaver::restoreInProgress()) {
         // don't resize anything while we're restoring the layout
-        setLayoutSize(newSize);
+        if (shouldDeferResize()) {
+            // Restarts the timer, so we only lay out once the user stops resizing
+            if (!m_pendingResizeTimer) {
+                m_pendingResizeTimer = new QTimer(this);
+                m_pendingResizeTimer->setSingleShot(true);
+                m_pendingResizeTimer->setInterval(s_lazyMainWindowResizeDelay);
+                connect(m_pendingResizeTimer, &QTimer::timeout, this, &LayoutWidget::applyPendingResize);
+            }
+            m_pendingResizeTimer->start();
+        } else {
+            setLayoutSize(newSize);
+        }
     }
 
     return false; // So QWidget::resizeEvent is called
 }
 
+bool LayoutWidget::shouldDeferResize() const
+{
+    if (!(Config::self().flags() & Config::Flag_LazyMainWindowResize))
+        return false;
+
+    // Only the interactive case. The initial show is laid out right away, as there's nothing to
+    // show meanwhile. Floating windows are small and always laid out immediately.
+    return QWidgetAdapter::isVisible() && isInMainWindow();
+}
+
+void LayoutWidget::applyPendingResize()
+{
+    if (!hasPendingResize())
+        return;
+
+    m_pendingResizeTimer->stop();
+
+    // The widget already has the new size, we're just catching up
+    QScopedValueRollback<bool> resizeGuard(m_inResizeEvent, true);
+    if (!LayoutSaver::restoreInProgress())
+        setLayoutSize(QWidgetAdapter::size());
+}
+
+bool LayoutWidget::hasPendingResize() const
+{
+    return m_pendingResizeTimer && m_pendingResizeTimer->isActive();
+}
+
 LayoutSaver::MultiSplitter LayoutWidget::serialize() const
 {
     LayoutSaver::MultiSplitter l;
     l.layout = m_rootItem->toVariantMap();
-    const Layouting::Item::List items = m_rootItem->items_recursive();
-    l.frames.reserve(items.size());
-    for (Layouting::Item *item : items) {
-        if (!item->isContainer()) {
-            if (auto frame = qobject_cast<Frame *>(item->guestAsQObject()))
-                l.frames.insert(frame->id(), frame->serialize());
-        }
-    }
+    m_rootItem->forEachLeaf([&l](Layouting::Item *item) {
+        if (auto frame = qobject_cast<Frame *>(item->guestAsQObject()))
+            l.frames.insert(frame->id(), frame->serialize());
+        return true;
+    });
 
     return l;
 }
@@ -29,7 +29,16 @@
 #include "kddockwidgets/LayoutSaver.h"
 #include "kddockwidgets/QWidgetAdapter.h"
 
+#include <QHash>
 #include <QList>
+#include <QPointer>
+#include <QRect>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QMetaMethod;
+class QTimer;
+QT_END_NAMESPACE
 
 namespace Layouting {
 class Item;
@@ -45,6 +54,34 @@ class FloatingWindow;
 class Frame;
 class DockWidgetBase;
 
+/**
+ * @brief What changed in a layout since LayoutWidget::layoutChanged() was last emitted
+ *
+ * Only leaf items are reported, geometries are in layout coordinates.
+ */
+struct LayoutChanges
+{
+    struct ItemState
+    {
+        const Layouting::Item *item = nullptr;
+        QRect geometry;
+        bool isVisible = false;
+    };
+
+    QVector<ItemState> added;
+    QVector<ItemState> geometryChanged;
+    QVector<ItemState> visibilityChanged;
+
+    ///@brief Items which left the layout. They might be deleted already, only use them as keys.
+    QVector<const Layouting::Item *> removed;
+
+    bool isEmpty() const
+    {
+        return added.isEmpty() && removed.isEmpty() && geometryChanged.isEmpty()
+            && visibilityChanged.isEmpty();
+    }
+};
+
 /**
  * @brief The widget (QWidget or QQuickItem) which holds a layout of dock widgets.
  *
@@ -123,6 +160,12 @@ public:
      */
     void setLayoutSize(QSize);
 
+    /// @brief Lays out the items for the current size, if a resize was deferred.
+    /// Only relevant with Config::Flag_LazyMainWindowResize, otherwise the layout is always up to date.
+    void applyPendingResize();
+
+    /// @brief Returns whether a resize is waiting for the resizing to pause, see Config::Flag_LazyMainWindowResize
+    bool hasPendingResize() const;
 
     /// @brief restores the dockwidget @p dw to its previous position
     void restorePlaceholder(DockWidgetBase *dw, Layouting::Item *, int tabIndex);
@@ -201,6 +244,8 @@ protected:
 
     void onLayoutRequest() override;
     bool onResize(QSize newSize) override;
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
 
     /**
      * @brief Removes unneeded placeholder items when adding new frames.
@@ -223,11 +268,35 @@ protected:
 Q_SIGNALS:
     void visibleWidgetCountChanged(int count);
 
+    /// @brief Emitted at most once per event loop iteration, with everything that changed since
+    /// the previous emission. Replaces connecting to each item's signals.
+    /// The first emission after connecting reports all items as added.
+    void layoutChanged(const KDDockWidgets::LayoutChanges &);
+
 private:
+    struct TrackedItem
+    {
+        QPointer<const Layouting::Item> item; // To detect a new item reusing a deleted one's address
+        QRect geometry;
+        bool isVisible = false;
+    };
+
+    void scheduleLayoutChanged();
+    void emitLayoutChanged();
+    void updateDescendantGeometryTracking();
+
+    bool shouldDeferResize() const;
+
     bool m_inResizeEvent = false;
+    QTimer *m_pendingResizeTimer = nullptr;
+    bool m_layoutChangedScheduled = false;
     Layouting::ItemContainer *m_rootItem = nullptr;
+    QMetaObject::Connection m_descendantGeometryConnection;
+    QHash<const Layouting::Item *, TrackedItem> m_trackedItems;
 };
 
 }
 
+Q_DECLARE_METATYPE(KDDockWidgets::LayoutChanges)
+
 #endif
@@ -14,12 +14,14 @@
 #include "DockWidgetBase_p.h"
 #include "Config.h"
 #include "FrameworkWidgetFactory.h"
+#include "WidgetResizeHandler_p.h"
 
 using namespace KDDockWidgets;
 
 MDILayoutWidget::MDILayoutWidget(QWidgetOrQuick *parent)
     : LayoutWidget(parent)
     , m_rootItem(new Layouting::ItemFreeContainer(this))
+    , m_resizeController(new MDIResizeController(this))
 {
     setRootItem(m_rootItem);
 }
@@ -114,3 +116,8 @@ void MDILayoutWidget::resizeDockWidget(Frame *frame, QSize size)
 
     item->setSize(size.expandedTo(frame->minimumSize()));
 }
+
+MDIResizeController *MDILayoutWidget::resizeController() const
+{
+    return m_resizeController;
+}
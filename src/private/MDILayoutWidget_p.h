@@ -24,6 +24,8 @@ class ItemFreeContainer;
 
 namespace KDDockWidgets {
 
+class MDIResizeController;
+
 /**
  * @brief The MDILayoutWidget class implements a layout suitable for MDI style docking.
  * Where dock widgets are free to be positioned in arbitrary positions, not restricted by layouting.
@@ -55,8 +57,12 @@ public:
     /// @brief sets the size and position of the dock widget @p f
     void setDockWidgetGeometry(Frame *f, QRect);
 
+    /// @brief Returns the event filter shared by the resize handlers of this layout's frames
+    MDIResizeController *resizeController() const;
+
 private:
     Layouting::ItemFreeContainer *const m_rootItem;
+    MDIResizeController *const m_resizeController;
 };
 
 }
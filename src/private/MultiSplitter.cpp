@@ -23,6 +23,7 @@
 #include "DockRegistry_p.h"
 #include "DockWidgetBase.h"
 #include "DockWidgetBase_p.h"
+#include "DragStatistics_p.h"
 #include "FloatingWindow_p.h"
 #include "Frame_p.h"
 #include "FrameworkWidgetFactory.h"
@@ -234,6 +235,7 @@ QRect MultiSplitter::rectForDrop(const WindowBeingDragged *wbd, Location locatio
     Layouting::ItemBoxContainer *container = relativeTo ? relativeTo->parentBoxContainer()
                                                         : m_rootItem;
 
+    DragStatisticsCollector::self()->addSuggestedDropRectCall();
     return container->suggestedDropRect(&item, relativeTo, location);
 }
 
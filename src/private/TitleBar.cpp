@@ -15,6 +15,7 @@
 #include "Logging_p.h"
 #include "WindowBeingDragged_p.h"
 #include "Utils_p.h"
+#include "LayoutUndoStack.h"
 #include "FrameworkWidgetFactory.h"
 #include "Config.h"
 #include "MainWindowBase.h"
@@ -346,6 +347,7 @@ QIcon TitleBar::icon() const
 
 void TitleBar::onCloseClicked()
 {
+    LayoutUndoStack::Operation undoOperation;
     const bool closeOnlyCurrentTab = Config::self().flags() & Config::Flag_CloseOnlyCurrentTab;
 
     if (m_frame) {
@@ -422,6 +424,7 @@ DockWidgetBase::List TitleBar::dockWidgets() const
 
 void TitleBar::onFloatClicked()
 {
+    LayoutUndoStack::Operation undoOperation;
     const DockWidgetBase::List dockWidgets = this->dockWidgets();
     if (isFloating()) {
         // Let's dock it
@@ -495,6 +498,7 @@ void TitleBar::onMinimizeClicked()
 
 void TitleBar::onAutoHideClicked()
 {
+    LayoutUndoStack::Operation undoOperation;
     if (!m_frame) {
         // Doesn't happen
         qWarning() << Q_FUNC_INFO << "Minimize not supported on floating windows";
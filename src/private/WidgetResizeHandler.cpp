@@ -51,6 +51,11 @@ WidgetResizeHandler::WidgetResizeHandler(EventFilterMode filterMode, WindowMode
 
 WidgetResizeHandler::~WidgetResizeHandler()
 {
+    if (m_mdiResizeController)
+        m_mdiResizeController->unregisterHandler(this);
+
+    if (m_overridingCursor)
+        qApp->restoreOverrideCursor();
 }
 
 void WidgetResizeHandler::setAllowedResizeSides(CursorPositions sides)
@@ -451,7 +456,13 @@ void WidgetResizeHandler::setTarget(QWidgetOrQuick *w)
     if (w) {
         mTarget = w;
         mTarget->setMouseTracking(true);
-        if (m_usesGlobalEventFilter) {
+        auto frame = qobject_cast<Frame *>(mTarget);
+        MDILayoutWidget *mdiLayout = frame ? frame->mdiLayoutWidget() : nullptr;
+        if (m_usesGlobalEventFilter && mdiLayout) {
+            // MDI frames share a single event filter, which dispatches to the frame under the mouse
+            m_mdiResizeController = mdiLayout->resizeController();
+            m_mdiResizeController->registerHandler(this);
+        } else if (m_usesGlobalEventFilter) {
             qApp->installEventFilter(this);
         } else {
             mTarget->installEventFilter(this);
@@ -506,18 +517,29 @@ void WidgetResizeHandler::updateCursor(CursorPosition m)
 
 void WidgetResizeHandler::setMouseCursor(Qt::CursorShape cursor)
 {
-    if (m_usesGlobalEventFilter)
-        qApp->setOverrideCursor(cursor);
-    else
+    if (m_usesGlobalEventFilter) {
+        // Keep the override cursor stack balanced, this is called for every mouse move
+        if (m_overridingCursor) {
+            qApp->changeOverrideCursor(cursor);
+        } else {
+            qApp->setOverrideCursor(cursor);
+            m_overridingCursor = true;
+        }
+    } else {
         mTarget->setCursor(cursor);
+    }
 }
 
 void WidgetResizeHandler::restoreMouseCursor()
 {
-    if (m_usesGlobalEventFilter)
-        qApp->restoreOverrideCursor();
-    else
+    if (m_usesGlobalEventFilter) {
+        if (m_overridingCursor) {
+            qApp->restoreOverrideCursor();
+            m_overridingCursor = false;
+        }
+    } else {
         mTarget->setCursor(Qt::ArrowCursor);
+    }
 }
 
 CursorPosition WidgetResizeHandler::cursorPosition(QPoint globalPos) const
@@ -561,6 +583,165 @@ CursorPosition WidgetResizeHandler::cursorPosition(QPoint globalPos) const
     return static_cast<CursorPosition>(result);
 }
 
+MDIResizeController::MDIResizeController(MDILayoutWidget *layout)
+    : QObject(layout)
+    , m_layout(layout)
+{
+}
+
+MDIResizeController::~MDIResizeController()
+{
+}
+
+void MDIResizeController::registerHandler(WidgetResizeHandler *handler)
+{
+    if (m_handlers.isEmpty())
+        qApp->installEventFilter(this);
+
+    m_handlers.insert(handler->mTarget, handler);
+    invalidateHandlerRects();
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+    // QQuickItems don't get move and resize events, see eventFilter() for QtWidgets
+    QQuickItem *target = handler->mTarget;
+    for (auto signal : { &QQuickItem::xChanged, &QQuickItem::yChanged, &QQuickItem::widthChanged,
+                         &QQuickItem::heightChanged, &QQuickItem::visibleChanged, &QQuickItem::zChanged })
+        connect(target, signal, this, &MDIResizeController::invalidateHandlerRects);
+#endif
+}
+
+void MDIResizeController::unregisterHandler(WidgetResizeHandler *handler)
+{
+    auto it = m_handlers.find(handler->mTarget);
+    if (it == m_handlers.end() || it.value() != handler)
+        return;
+
+    m_handlers.erase(it);
+    invalidateHandlerRects();
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+    disconnect(handler->mTarget, nullptr, this, nullptr);
+#endif
+
+    if (m_handlers.isEmpty())
+        qApp->removeEventFilter(this);
+}
+
+int MDIResizeController::numHandlers() const
+{
+    return m_handlers.size();
+}
+
+void MDIResizeController::invalidateHandlerRects()
+{
+    m_handlerRectsDirty = true;
+}
+
+void MDIResizeController::updateHandlerRects() const
+{
+    if (!m_handlerRectsDirty)
+        return;
+
+    m_handlerRectsDirty = false;
+    m_handlerRects.clear();
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    const QObjectList children = m_layout->children();
+#else
+    const QList<QQuickItem *> children = m_layout->childItems();
+#endif
+    // The top-most first
+    for (auto it = children.crbegin(); it != children.crend(); ++it) {
+        auto frame = qobject_cast<Frame *>(*it);
+        if (!frame || !frame->QWidgetAdapter::isVisible())
+            continue;
+
+        if (WidgetResizeHandler *handler = m_handlers.value(frame))
+            m_handlerRects.push_back({ frame->QWidgetAdapter::geometry(), handler });
+    }
+}
+
+WidgetResizeHandler *MDIResizeController::handlerForEvent(QWidgetOrQuick *receiver, QPoint globalPos) const
+{
+    // For example a popup over the layout
+    if (Private::windowForWidget(receiver) != Private::windowForWidget(m_layout))
+        return nullptr;
+
+    const int margin = WidgetResizeHandler::widgetResizeHandlerMargin();
+    const QMargins margins(margin, margin, margin, margin);
+    const QPoint localPos = m_layout->mapFromGlobal(globalPos);
+    if (!m_layout->rect().marginsAdded(margins).contains(localPos))
+        return nullptr;
+
+    updateHandlerRects();
+
+    // Frames can overlap. If the mouse is over one of our frames then only that one can be resized.
+    for (const HandlerRect &handlerRect : qAsConst(m_handlerRects)) {
+        if (handlerRect.rect.contains(localPos))
+            return handlerRect.handler;
+    }
+
+    // Otherwise the mouse might be in the resize margin just outside of a frame
+    for (const HandlerRect &handlerRect : qAsConst(m_handlerRects)) {
+        if (handlerRect.rect.marginsAdded(margins).contains(localPos))
+            return handlerRect.handler;
+    }
+
+    return nullptr;
+}
+
+bool MDIResizeController::eventFilter(QObject *o, QEvent *e)
+{
+    switch (e->type()) {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseMove:
+        break;
+    case QEvent::Move:
+    case QEvent::Resize:
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::ZOrderChange:
+        // One of our frames changed geometry, visibility or stacking order
+        if (m_handlers.contains(o))
+            invalidateHandlerRects();
+        return false;
+    default:
+        return false;
+    }
+
+    if (WidgetResizeHandler::s_disableAllHandlers)
+        return false;
+
+    auto me = static_cast<QMouseEvent *>(e);
+
+    // A resize in progress gets all mouse events, wherever the mouse is
+    if (m_resizingHandler && m_resizingHandler->isResizing())
+        return m_resizingHandler->eventFilter(o, e);
+
+    // The resize handlers ignore events for QWindows, so do we. Otherwise the window and the widget
+    // receiving the same mouse event could resolve to different handlers.
+    auto receiver = qobject_cast<QWidgetOrQuick *>(o);
+    if (!receiver)
+        return false;
+
+    WidgetResizeHandler *handler = handlerForEvent(receiver, Qt5Qt6Compat::eventGlobalPos(me));
+    if (m_hoveredHandler && m_hoveredHandler != handler) {
+        // The mouse left the previous frame, which won't get any more events
+        m_hoveredHandler->updateCursor(CursorPosition_Undefined);
+    }
+
+    m_hoveredHandler = handler;
+    if (!handler)
+        return false;
+
+    const bool consumed = handler->eventFilter(o, e);
+    if (handler->isResizing())
+        m_resizingHandler = handler;
+
+    return consumed;
+}
+
 /** static */
 void WidgetResizeHandler::setupWindow(QWindow *window)
 {
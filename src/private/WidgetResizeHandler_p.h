@@ -20,6 +20,9 @@
 
 #include <QPoint>
 #include <QPointer>
+#include <QHash>
+#include <QRect>
+#include <QVector>
 #include <QDebug>
 #include <QAbstractNativeEventFilter>
 
@@ -30,6 +33,8 @@ QT_END_NAMESPACE
 namespace KDDockWidgets {
 
 class FloatingWindow;
+class MDILayoutWidget;
+class MDIResizeController;
 
 
 class DOCKS_EXPORT WidgetResizeHandler : public QObject
@@ -153,6 +158,7 @@ protected:
     bool eventFilter(QObject *o, QEvent *e) override;
 
 private:
+    friend class MDIResizeController;
     void setTarget(QWidgetOrQuick *w);
     bool mouseMoveEvent(QMouseEvent *e);
     void updateCursor(CursorPosition m);
@@ -167,6 +173,52 @@ private:
     const bool m_isTopLevelWindowResizer;
     int m_resizeGap = 10;
     CursorPositions mAllowedResizeSides = CursorPosition_All;
+    bool m_overridingCursor = false;
+    QPointer<MDIResizeController> m_mdiResizeController;
+};
+
+/**
+ * @brief Shared event filter for the resize handlers of all frames of a MDILayoutWidget.
+ *
+ * Instead of each MDI frame's WidgetResizeHandler filtering every application mouse event, and
+ * computing its cursor position, a single filter hit-tests the frame edges and dispatches the event
+ * to the resize handler of the frame under the mouse only.
+ */
+class DOCKS_EXPORT MDIResizeController : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MDIResizeController(MDILayoutWidget *layout);
+    ~MDIResizeController() override;
+
+    void registerHandler(WidgetResizeHandler *);
+    void unregisterHandler(WidgetResizeHandler *);
+
+    /// @brief Returns the number of registered resize handlers. For tests.
+    int numHandlers() const;
+
+protected:
+    bool eventFilter(QObject *o, QEvent *e) override;
+
+private:
+    struct HandlerRect
+    {
+        QRect rect; // In layout coordinates
+        WidgetResizeHandler *handler;
+    };
+
+    void invalidateHandlerRects();
+    void updateHandlerRects() const;
+    WidgetResizeHandler *handlerForEvent(QWidgetOrQuick *receiver, QPoint globalPos) const;
+    MDILayoutWidget *const m_layout;
+    QHash<QObject *, WidgetResizeHandler *> m_handlers;
+
+    // The rects of the visible frames, the top-most first. Rebuilt lazily when a frame moves,
+    // resizes, shows, hides or is raised.
+    mutable QVector<HandlerRect> m_handlerRects;
+    mutable bool m_handlerRectsDirty = true;
+    QPointer<WidgetResizeHandler> m_hoveredHandler;
+    QPointer<WidgetResizeHandler> m_resizingHandler;
 };
 
 #if defined(Q_OS_WIN) && defined(KDDOCKWIDGETS_QTWIDGETS)
@@ -31,18 +31,99 @@ static IndicatorWindow *createIndicatorWindow(ClassicIndicators *classicIndicato
     return window;
 }
 
+namespace {
+
+/// @brief The top-level windows shared by all ClassicIndicators instances
+/// Only one DropArea is hovered at a time, so instead of each one having its own hidden translucent
+/// top-levels, they're retargeted to whichever DropArea is hovered.
+struct SharedOverlayWindows
+{
+    IndicatorWindow *indicatorWindow = nullptr;
+    QWidgetOrQuick *rubberBand = nullptr;
+    QVector<ClassicIndicators *> users;
+};
+
+SharedOverlayWindows &sharedOverlayWindows()
+{
+    static SharedOverlayWindows s_windows;
+    return s_windows;
+}
+
+}
+
+static bool indicatorWindowIsShared()
+{
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    // On Wayland the indicator window is a child of the overlay, so can't be shared
+    return !isWayland();
+#else
+    return true;
+#endif
+}
+
+static IndicatorWindow *acquireIndicatorWindow(ClassicIndicators *classicIndicators)
+{
+    if (!indicatorWindowIsShared())
+        return createIndicatorWindow(classicIndicators);
+
+    SharedOverlayWindows &shared = sharedOverlayWindows();
+    if (!shared.indicatorWindow)
+        shared.indicatorWindow = createIndicatorWindow(classicIndicators);
+
+    return shared.indicatorWindow;
+}
+
+static QWidgetOrQuick *acquireRubberBand(DropArea *dropArea, bool topLevel)
+{
+    if (!topLevel)
+        return Config::self().frameworkWidgetFactory()->createRubberBand(dropArea);
+
+    SharedOverlayWindows &shared = sharedOverlayWindows();
+    if (!shared.rubberBand) {
+        shared.rubberBand = Config::self().frameworkWidgetFactory()->createRubberBand(nullptr);
+        shared.rubberBand->setWindowOpacity(0.5);
+    }
+
+    return shared.rubberBand;
+}
+
 ClassicIndicators::ClassicIndicators(DropArea *dropArea)
     : DropIndicatorOverlayInterface(dropArea) // Is parented on the drop-area, not a toplevel.
-    , m_rubberBand(Config::self().frameworkWidgetFactory()->createRubberBand(rubberBandIsTopLevel() ? nullptr : dropArea))
-    , m_indicatorWindow(createIndicatorWindow(this))
+    , m_rubberBand(acquireRubberBand(dropArea, rubberBandIsTopLevel()))
+    , m_indicatorWindow(acquireIndicatorWindow(this))
 {
-    if (rubberBandIsTopLevel())
-        m_rubberBand->setWindowOpacity(0.5);
+    sharedOverlayWindows().users.push_back(this);
 }
 
 ClassicIndicators::~ClassicIndicators()
 {
-    delete m_indicatorWindow;
+    SharedOverlayWindows &shared = sharedOverlayWindows();
+    shared.users.removeOne(this);
+    const bool isTarget = isIndicatorWindowTarget();
+
+    if (m_indicatorWindow != shared.indicatorWindow) {
+        delete m_indicatorWindow;
+    } else if (shared.users.isEmpty()) {
+        delete shared.indicatorWindow;
+        shared.indicatorWindow = nullptr;
+    } else if (isTarget) {
+        m_indicatorWindow->setVisible(false);
+        m_indicatorWindow->setClassicIndicators(shared.users.constFirst());
+    }
+
+    if (m_rubberBand == shared.rubberBand) {
+        if (shared.users.isEmpty()) {
+            delete shared.rubberBand;
+            shared.rubberBand = nullptr;
+        } else if (isTarget) {
+            m_rubberBand->setVisible(false);
+        }
+    }
+}
+
+bool ClassicIndicators::isIndicatorWindowTarget() const
+{
+    return m_indicatorWindow->classicIndicators() == this;
 }
 
 DropLocation ClassicIndicators::hover_impl(QPoint globalPos)
@@ -102,20 +183,27 @@ bool ClassicIndicators::tabIndicatorVisible() const
 
 bool ClassicIndicators::onResize(QSize)
 {
-    m_indicatorWindow->resize(window()->size());
+    if (isIndicatorWindowTarget())
+        m_indicatorWindow->resize(window()->size());
     return false;
 }
 
 void ClassicIndicators::updateVisibility()
 {
     if (isHovered()) {
+        m_indicatorWindow->setClassicIndicators(this);
         m_indicatorWindow->updatePositions();
         m_indicatorWindow->setVisible(true);
         updateWindowPosition();
         raiseIndicators();
     } else {
-        m_rubberBand->setVisible(false);
-        m_indicatorWindow->setVisible(false);
+        // If shared, another DropArea might be using the windows already. Our own rubber band
+        // however is a child of our DropArea, nobody else will hide it.
+        const bool isTarget = isIndicatorWindowTarget();
+        if (isTarget || m_rubberBand != sharedOverlayWindows().rubberBand)
+            m_rubberBand->setVisible(false);
+        if (isTarget)
+            m_indicatorWindow->setVisible(false);
     }
 
     Q_EMIT indicatorsVisibleChanged();
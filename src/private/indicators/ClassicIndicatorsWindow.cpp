@@ -66,42 +66,78 @@ static QString iconName(DropLocation loc, bool active)
 #ifdef KDDOCKWIDGETS_QTWIDGETS
 
 #include <QPainter>
+#include <QPixmapCache>
 
 #define INDICATOR_WIDTH 40
 #define OUTTER_INDICATOR_MARGIN 10
 
-void Indicator::paintEvent(QPaintEvent *)
+static const DropLocation s_indicatorLocations[] = {
+    DropLocation_Center, DropLocation_Left, DropLocation_Right, DropLocation_Top, DropLocation_Bottom,
+    DropLocation_OutterBottom, DropLocation_OutterTop, DropLocation_OutterLeft, DropLocation_OutterRight
+};
+
+static const int s_numIndicators = int(sizeof(s_indicatorLocations) / sizeof(s_indicatorLocations[0]));
+
+static int atlasIndexForLocation(DropLocation loc)
 {
-    QPainter p(this);
-    if (m_hovered)
-        p.drawImage(rect(), m_imageActive, rect());
-    else
-        p.drawImage(rect(), m_image, rect());
+    for (int i = 0; i < s_numIndicators; ++i) {
+        if (s_indicatorLocations[i] == loc)
+            return i;
+    }
+
+    return -1;
 }
 
-void Indicator::setHovered(bool hovered)
+static QString iconFileName(DropLocation loc, bool active)
 {
-    if (hovered != m_hovered) {
-        m_hovered = hovered;
-        update();
-        if (hovered) {
-            q->setDropLocation(m_dropLocation);
-        } else if (q->currentDropLocation() == m_dropLocation) {
-            q->setDropLocation(DropLocation_None);
-        }
-    }
+    const QString name = KDDockWidgets::iconName(loc, active);
+    return KDDockWidgets::windowManagerHasTranslucency() ? QStringLiteral(":/img/classic_indicators/%1.png").arg(name)
+                                                         : QStringLiteral(":/img/classic_indicators/opaque/%1.png").arg(name);
 }
 
-QString Indicator::iconName(bool active) const
+static int atlasTileSize(qreal dpr)
 {
-    return KDDockWidgets::iconName(m_dropLocation, active);
+    return qRound(INDICATOR_WIDTH * dpr);
 }
 
-QString Indicator::iconFileName(bool active) const
+QRect IndicatorWindow::atlasRectForIndicator(DropLocation loc, bool active, qreal dpr)
 {
-    const QString name = iconName(active);
-    return KDDockWidgets::windowManagerHasTranslucency() ? QStringLiteral(":/img/classic_indicators/%1.png").arg(name)
-                                                         : QStringLiteral(":/img/classic_indicators/opaque/%1.png").arg(name);
+    const int index = atlasIndexForLocation(loc);
+    if (index == -1)
+        return {};
+
+    const int tileSize = atlasTileSize(dpr);
+    return QRect((index * 2 + (active ? 1 : 0)) * tileSize, 0, tileSize, tileSize);
+}
+
+QPixmap IndicatorWindow::indicatorAtlas(qreal dpr)
+{
+    const bool translucent = KDDockWidgets::windowManagerHasTranslucency();
+    const QString key = QStringLiteral("_kddw_classic_indicators_%1_%2").arg(dpr).arg(translucent ? 1 : 0);
+
+    QPixmap atlas;
+    if (QPixmapCache::find(key, &atlas))
+        return atlas;
+
+    // A single row with the normal and active icon of each location, pre-scaled to the final
+    // size in device pixels, so painting is a plain blit
+    const int tileSize = atlasTileSize(dpr);
+    atlas = QPixmap(tileSize * s_numIndicators * 2, tileSize);
+    atlas.fill(Qt::transparent);
+
+    {
+        QPainter p(&atlas);
+        p.setRenderHint(QPainter::SmoothPixmapTransform);
+        for (DropLocation loc : s_indicatorLocations) {
+            for (bool active : { false, true })
+                p.drawImage(atlasRectForIndicator(loc, active, dpr), QImage(iconFileName(loc, active)));
+        }
+    }
+
+    atlas.setDevicePixelRatio(dpr);
+    QPixmapCache::insert(key, atlas);
+
+    return atlas;
 }
 
 static QWidgetAdapter *parentForIndicatorWindow(ClassicIndicators *classicIndicators_)
@@ -120,16 +156,7 @@ static Qt::WindowFlags flagsForIndicatorWindow()
 
 IndicatorWindow::IndicatorWindow(ClassicIndicators *classicIndicators_)
     : QWidget(parentForIndicatorWindow(classicIndicators_), flagsForIndicatorWindow())
-    , classicIndicators(classicIndicators_)
-    , m_center(new Indicator(classicIndicators, this, DropLocation_Center)) // Each indicator is not a top-level. Otherwise there's noticeable delay.
-    , m_left(new Indicator(classicIndicators, this, DropLocation_Left))
-    , m_right(new Indicator(classicIndicators, this, DropLocation_Right))
-    , m_bottom(new Indicator(classicIndicators, this, DropLocation_Bottom))
-    , m_top(new Indicator(classicIndicators, this, DropLocation_Top))
-    , m_outterLeft(new Indicator(classicIndicators, this, DropLocation_OutterLeft))
-    , m_outterRight(new Indicator(classicIndicators, this, DropLocation_OutterRight))
-    , m_outterBottom(new Indicator(classicIndicators, this, DropLocation_OutterBottom))
-    , m_outterTop(new Indicator(classicIndicators, this, DropLocation_OutterTop))
+    , m_classicIndicators(classicIndicators_)
 {
     setWindowFlag(Qt::FramelessWindowHint, true);
 
@@ -140,45 +167,44 @@ IndicatorWindow::IndicatorWindow(ClassicIndicators *classicIndicators_)
 
     setAttribute(Qt::WA_TranslucentBackground);
 
-    connect(classicIndicators, &ClassicIndicators::indicatorsVisibleChanged,
+    connect(m_classicIndicators, &ClassicIndicators::indicatorsVisibleChanged,
             this, &IndicatorWindow::updateIndicatorVisibility);
-    connect(classicIndicators, &ClassicIndicators::indicatorsVisibleChanged,
+
+    m_indicators.reserve(s_numIndicators);
+    for (DropLocation loc : s_indicatorLocations)
+        m_indicators.push_back({ loc, QRect(0, 0, INDICATOR_WIDTH, INDICATOR_WIDTH), true });
+}
+
+ClassicIndicators *IndicatorWindow::classicIndicators() const
+{
+    return m_classicIndicators;
+}
+
+void IndicatorWindow::setClassicIndicators(ClassicIndicators *classicIndicators_)
+{
+    if (classicIndicators_ == m_classicIndicators)
+        return;
+
+    disconnect(m_classicIndicators, &ClassicIndicators::indicatorsVisibleChanged,
+               this, &IndicatorWindow::updateIndicatorVisibility);
+    m_classicIndicators = classicIndicators_;
+    connect(m_classicIndicators, &ClassicIndicators::indicatorsVisibleChanged,
             this, &IndicatorWindow::updateIndicatorVisibility);
 
-    m_indicators << m_center << m_left << m_right << m_top << m_bottom
-                 << m_outterBottom << m_outterTop << m_outterLeft << m_outterRight;
+    m_hoveredLocation = DropLocation_None;
+    updateIndicatorVisibility();
 }
 
-Indicator *IndicatorWindow::indicatorForLocation(DropLocation loc) const
+IndicatorWindow::Indicator *IndicatorWindow::indicatorForLocation(DropLocation loc)
 {
-    switch (loc) {
-    case DropLocation_Center:
-        return m_center;
-    case DropLocation_Left:
-        return m_left;
-    case DropLocation_Right:
-        return m_right;
-    case DropLocation_Bottom:
-        return m_bottom;
-    case DropLocation_Top:
-        return m_top;
-    case DropLocation_OutterLeft:
-        return m_outterLeft;
-    case DropLocation_OutterBottom:
-        return m_outterBottom;
-    case DropLocation_OutterRight:
-        return m_outterRight;
-    case DropLocation_OutterTop:
-        return m_outterTop;
-    case DropLocation_None:
-    case DropLocation_Outter:
-    case DropLocation_Inner:
-    case DropLocation_Horizontal:
-    case DropLocation_Vertical:
-        return nullptr;
-    }
+    const int index = atlasIndexForLocation(loc);
+    return index == -1 ? nullptr : &m_indicators[index];
+}
 
-    return nullptr;
+const IndicatorWindow::Indicator *IndicatorWindow::indicatorForLocation(DropLocation loc) const
+{
+    const int index = atlasIndexForLocation(loc);
+    return index == -1 ? nullptr : &m_indicators.at(index);
 }
 
 void IndicatorWindow::updateMask()
@@ -186,9 +212,9 @@ void IndicatorWindow::updateMask()
     QRegion region;
 
     if (!KDDockWidgets::windowManagerHasTranslucency()) {
-        for (Indicator *indicator : qAsConst(m_indicators)) {
-            if (indicator->isVisible())
-                region = region.united(QRegion(indicator->geometry(), QRegion::Rectangle));
+        for (const Indicator &indicator : qAsConst(m_indicators)) {
+            if (indicator.visible)
+                region = region.united(QRegion(indicator.rect, QRegion::Rectangle));
         }
     }
 
@@ -201,68 +227,96 @@ void IndicatorWindow::resizeEvent(QResizeEvent *ev)
     updatePositions();
 }
 
+void IndicatorWindow::paintEvent(QPaintEvent *ev)
+{
+    const qreal dpr = devicePixelRatioF();
+    const QPixmap atlas = indicatorAtlas(dpr);
+
+    QPainter p(this);
+    for (const Indicator &indicator : qAsConst(m_indicators)) {
+        if (indicator.visible && ev->rect().intersects(indicator.rect)) {
+            const bool active = indicator.location == m_hoveredLocation;
+            p.drawPixmap(indicator.rect, atlas, atlasRectForIndicator(indicator.location, active, dpr));
+        }
+    }
+}
+
 void IndicatorWindow::updateIndicatorVisibility()
 {
-    for (Indicator *indicator : { m_left, m_right, m_bottom, m_top,
-                                  m_outterTop, m_outterLeft, m_outterRight, m_outterBottom,
-                                  m_center })
-        indicator->setVisible(classicIndicators->dropIndicatorVisible(indicator->m_dropLocation));
+    for (Indicator &indicator : m_indicators)
+        indicator.visible = m_classicIndicators->dropIndicatorVisible(indicator.location);
 
     updateMask();
+    update();
 }
 
 QPoint IndicatorWindow::posForIndicator(DropLocation loc) const
 {
-    Indicator *indicator = indicatorForLocation(loc);
-    return indicator->mapToGlobal(indicator->rect().center());
+    const Indicator *indicator = indicatorForLocation(loc);
+    return indicator ? mapToGlobal(indicator->rect.center())
+                     : QPoint();
 }
 
 DropLocation IndicatorWindow::hover(QPoint globalPos)
 {
+    const QPoint localPos = mapFromGlobal(globalPos);
     DropLocation loc = DropLocation_None;
 
-    for (Indicator *indicator : qAsConst(m_indicators)) {
-        if (indicator->isVisible()) {
-            const bool hovered = indicator->rect().contains(indicator->mapFromGlobal(globalPos));
-            indicator->setHovered(hovered);
-            if (hovered)
-                loc = indicator->m_dropLocation;
+    for (const Indicator &indicator : qAsConst(m_indicators)) {
+        if (indicator.visible && indicator.rect.contains(localPos)) {
+            loc = indicator.location;
+            break;
         }
     }
 
+    setHoveredLocation(loc);
+
     return loc;
 }
 
+void IndicatorWindow::setHoveredLocation(DropLocation loc)
+{
+    if (loc != m_hoveredLocation) {
+        // Only repaint the two indicators whose icon changes
+        if (const Indicator *old = indicatorForLocation(m_hoveredLocation))
+            update(old->rect);
+        if (const Indicator *current = indicatorForLocation(loc))
+            update(current->rect);
+
+        m_hoveredLocation = loc;
+    }
+
+    if (m_classicIndicators->currentDropLocation() != loc)
+        m_classicIndicators->setDropLocation(loc);
+}
+
 void IndicatorWindow::updatePositions()
 {
     QRect r = rect();
-    const int indicatorWidth = m_outterBottom->width();
-    const int halfIndicatorWidth = m_outterBottom->width() / 2;
-
-    m_outterLeft->move(r.x() + OUTTER_INDICATOR_MARGIN, r.center().y() - halfIndicatorWidth);
-    m_outterBottom->move(r.center().x() - halfIndicatorWidth, r.y() + height() - indicatorWidth - OUTTER_INDICATOR_MARGIN);
-    m_outterTop->move(r.center().x() - halfIndicatorWidth, r.y() + OUTTER_INDICATOR_MARGIN);
-    m_outterRight->move(r.x() + width() - indicatorWidth - OUTTER_INDICATOR_MARGIN, r.center().y() - halfIndicatorWidth);
-    Frame *hoveredFrame = classicIndicators->m_hoveredFrame;
+    const int indicatorWidth = INDICATOR_WIDTH;
+    const int halfIndicatorWidth = INDICATOR_WIDTH / 2;
+
+    auto moveIndicator = [this](DropLocation loc, QPoint pos) {
+        indicatorForLocation(loc)->rect.moveTopLeft(pos);
+    };
+
+    moveIndicator(DropLocation_OutterLeft, QPoint(r.x() + OUTTER_INDICATOR_MARGIN, r.center().y() - halfIndicatorWidth));
+    moveIndicator(DropLocation_OutterBottom, QPoint(r.center().x() - halfIndicatorWidth, r.y() + height() - indicatorWidth - OUTTER_INDICATOR_MARGIN));
+    moveIndicator(DropLocation_OutterTop, QPoint(r.center().x() - halfIndicatorWidth, r.y() + OUTTER_INDICATOR_MARGIN));
+    moveIndicator(DropLocation_OutterRight, QPoint(r.x() + width() - indicatorWidth - OUTTER_INDICATOR_MARGIN, r.center().y() - halfIndicatorWidth));
+    Frame *hoveredFrame = m_classicIndicators->m_hoveredFrame;
     if (hoveredFrame) {
         QRect hoveredRect = hoveredFrame->QWidget::geometry();
-        m_center->move(r.topLeft() + hoveredRect.center() - QPoint(halfIndicatorWidth, halfIndicatorWidth));
-        m_top->move(m_center->pos() - QPoint(0, indicatorWidth + OUTTER_INDICATOR_MARGIN));
-        m_right->move(m_center->pos() + QPoint(indicatorWidth + OUTTER_INDICATOR_MARGIN, 0));
-        m_bottom->move(m_center->pos() + QPoint(0, indicatorWidth + OUTTER_INDICATOR_MARGIN));
-        m_left->move(m_center->pos() - QPoint(indicatorWidth + OUTTER_INDICATOR_MARGIN, 0));
+        const QPoint centerPos = r.topLeft() + hoveredRect.center() - QPoint(halfIndicatorWidth, halfIndicatorWidth);
+        moveIndicator(DropLocation_Center, centerPos);
+        moveIndicator(DropLocation_Top, centerPos - QPoint(0, indicatorWidth + OUTTER_INDICATOR_MARGIN));
+        moveIndicator(DropLocation_Right, centerPos + QPoint(indicatorWidth + OUTTER_INDICATOR_MARGIN, 0));
+        moveIndicator(DropLocation_Bottom, centerPos + QPoint(0, indicatorWidth + OUTTER_INDICATOR_MARGIN));
+        moveIndicator(DropLocation_Left, centerPos - QPoint(indicatorWidth + OUTTER_INDICATOR_MARGIN, 0));
     }
-}
 
-Indicator::Indicator(ClassicIndicators *classicIndicators, IndicatorWindow *parent, DropLocation location)
-    : QWidget(parent)
-    , q(classicIndicators)
-    , m_dropLocation(location)
-{
-    m_image = QImage(iconFileName(/*active=*/false)).scaled(INDICATOR_WIDTH, INDICATOR_WIDTH);
-    m_imageActive = QImage(iconFileName(/*active=*/true)).scaled(INDICATOR_WIDTH, INDICATOR_WIDTH);
-    setFixedSize(m_image.size());
-    setVisible(true);
+    updateMask();
+    update();
 }
 
 #else
@@ -348,6 +402,15 @@ ClassicIndicators *IndicatorWindow::classicIndicators() const
     return m_classicIndicators;
 }
 
+void IndicatorWindow::setClassicIndicators(ClassicIndicators *classicIndicators)
+{
+    if (classicIndicators == m_classicIndicators)
+        return;
+
+    m_classicIndicators = classicIndicators;
+    Q_EMIT classicIndicatorsChanged();
+}
+
 QQuickItem *IndicatorWindow::indicatorForLocation(DropLocation loc) const
 {
     const QVector<QQuickItem *> indicators = indicatorItems();
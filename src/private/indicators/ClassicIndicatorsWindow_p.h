@@ -17,13 +17,12 @@
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
 
-#include <QImage>
+#include <QPixmap>
 #include <QWidget>
 #include <QResizeEvent>
 
 namespace KDDockWidgets {
 
-class Indicator;
 class ClassicIndicators;
 
 class IndicatorWindow : public QWidget
@@ -35,7 +34,30 @@ public:
     void updatePositions();
     QPoint posForIndicator(DropLocation) const;
 
+    ///@brief The overlay this window is showing indicators for
+    ClassicIndicators *classicIndicators() const;
+
+    ///@brief Retargets the window to another overlay, as the window is shared by all DropAreas
+    void setClassicIndicators(ClassicIndicators *);
+
+    /// @brief Returns the pixmap holding all indicator icons, for the specified device pixel ratio
+    /// It's loaded and scaled once and then shared by all indicator windows, via QPixmapCache.
+    static QPixmap indicatorAtlas(qreal dpr);
+
+    /// @brief Returns the rect of the icon for @p loc inside the atlas, in device pixels
+    static QRect atlasRectForIndicator(DropLocation loc, bool active, qreal dpr);
+
+protected:
+    void paintEvent(QPaintEvent *) override;
+
 private:
+    struct Indicator
+    {
+        DropLocation location;
+        QRect rect; // In IndicatorWindow coordinates
+        bool visible;
+    };
+
     void updateIndicatorVisibility();
     void resizeEvent(QResizeEvent *ev) override;
 
@@ -43,39 +65,16 @@ private:
     // Only happens on Linux
     void updateMask();
 
-    Indicator *indicatorForLocation(DropLocation loc) const;
-
-    ClassicIndicators *const classicIndicators;
-    Indicator *const m_center;
-    Indicator *const m_left;
-    Indicator *const m_right;
-    Indicator *const m_bottom;
-    Indicator *const m_top;
-    Indicator *const m_outterLeft;
-    Indicator *const m_outterRight;
-    Indicator *const m_outterBottom;
-    Indicator *const m_outterTop;
-    QVector<Indicator *> m_indicators;
-};
+    Indicator *indicatorForLocation(DropLocation loc);
+    const Indicator *indicatorForLocation(DropLocation loc) const;
+    void setHoveredLocation(DropLocation loc);
 
-class Indicator : public QWidget
-{
-    Q_OBJECT
-public:
-    typedef QList<Indicator *> List;
-    explicit Indicator(ClassicIndicators *classicIndicators, IndicatorWindow *parent,
-                       DropLocation location);
-    void paintEvent(QPaintEvent *) override;
-
-    void setHovered(bool hovered);
-    QString iconName(bool active) const;
-    QString iconFileName(bool active) const;
+    ClassicIndicators *m_classicIndicators;
 
-    QImage m_image;
-    QImage m_imageActive;
-    ClassicIndicators *const q;
-    bool m_hovered = false;
-    const DropLocation m_dropLocation;
+    // Plain rects instead of child widgets. All indicators are painted by a single paintEvent
+    // and hit-testing doesn't need any coordinate mapping per indicator.
+    QVector<Indicator> m_indicators;
+    DropLocation m_hoveredLocation = DropLocation_None;
 };
 }
 
@@ -89,7 +88,7 @@ class ClassicIndicators;
 class IndicatorWindow : public QQuickView
 {
     Q_OBJECT
-    Q_PROPERTY(KDDockWidgets::ClassicIndicators *classicIndicators READ classicIndicators CONSTANT)
+    Q_PROPERTY(KDDockWidgets::ClassicIndicators *classicIndicators READ classicIndicators NOTIFY classicIndicatorsChanged)
 public:
     explicit IndicatorWindow(ClassicIndicators *);
     DropLocation hover(QPoint);
@@ -97,13 +96,17 @@ public:
     QPoint posForIndicator(DropLocation) const;
     Q_INVOKABLE QString iconName(int loc, bool active) const;
     KDDockWidgets::ClassicIndicators *classicIndicators() const;
+    void setClassicIndicators(ClassicIndicators *);
     QQuickItem *indicatorForLocation(DropLocation loc) const;
 
+Q_SIGNALS:
+    void classicIndicatorsChanged();
+
 private:
     DropLocation locationForIndicator(const QQuickItem *) const;
     QQuickItem *indicatorForPos(QPoint) const;
     QVector<QQuickItem *> indicatorItems() const;
-    ClassicIndicators *const m_classicIndicators;
+    ClassicIndicators *m_classicIndicators;
 };
 }
 
@@ -17,7 +17,6 @@
 namespace KDDockWidgets {
 
 class IndicatorWindow;
-class Indicator;
 
 class DOCKS_EXPORT ClassicIndicators : public DropIndicatorOverlayInterface
 {
@@ -60,9 +59,9 @@ Q_SIGNALS:
     void indicatorsVisibleChanged();
 
 private:
-    friend class KDDockWidgets::Indicator;
     friend class KDDockWidgets::IndicatorWindow;
     bool rubberBandIsTopLevel() const;
+    bool isIndicatorWindowTarget() const;
     void raiseIndicators();
     QRect geometryForRubberband(QRect localRect) const;
     void setDropLocation(DropLocation);
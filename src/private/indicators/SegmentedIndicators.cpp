@@ -15,6 +15,7 @@
 
 #include <QPainter>
 #include <QPainterPath>
+#include <QPaintEvent>
 
 using namespace KDDockWidgets;
 
@@ -46,29 +47,38 @@ SegmentedIndicators::~SegmentedIndicators()
 
 DropLocation SegmentedIndicators::hover_impl(QPoint pt)
 {
-    m_hoveredPt = mapFromGlobal(pt);
-    updateSegments();
-    setCurrentDropLocation(dropLocationForPos(m_hoveredPt));
+    ensureSegments();
 
-    return currentDropLocation();
+    const DropLocation loc = dropLocationForPos(mapFromGlobal(pt));
+    setHoveredLocation(loc);
+    setCurrentDropLocation(loc);
+
+    return loc;
 }
 
 DropLocation SegmentedIndicators::dropLocationForPos(QPoint pos) const
 {
-    for (auto it = m_segments.cbegin(), end = m_segments.cend(); it != end; ++it) {
-        if (it.value().containsPoint(pos, Qt::OddEvenFill)) {
-            return it.key();
+    for (const Segment &segment : m_segments) {
+        // Cheap rect rejection first, most segments are far from the cursor
+        if (segment.boundingRect.contains(pos) && segment.polygon.containsPoint(pos, Qt::OddEvenFill)) {
+            return segment.location;
         }
     }
 
     return DropLocation_None;
 }
 
-void SegmentedIndicators::paintEvent(QPaintEvent *)
+void SegmentedIndicators::paintEvent(QPaintEvent *ev)
 {
     QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing, true);
-    drawSegments(&p);
+    drawSegments(&p, ev->rect());
+}
+
+void SegmentedIndicators::updateVisibility()
+{
+    // Which segments are shown depends on the hovered frame and on what's being dragged
+    m_segmentsDirty = true;
 }
 
 QHash<DropLocation, QPolygon> SegmentedIndicators::segmentsForRect(QRect r, bool inner, bool useOffset) const
@@ -146,15 +156,30 @@ QHash<DropLocation, QPolygon> SegmentedIndicators::segmentsForRect(QRect r, bool
     }
 }
 
+void SegmentedIndicators::ensureSegments()
+{
+    if (m_segmentsDirty || m_segmentsRect != rect() || m_segmentsHoveredFrameRect != hoveredFrameRect())
+        updateSegments();
+}
+
 void SegmentedIndicators::updateSegments()
 {
     m_segments.clear();
+    m_segmentsRect = rect();
+    m_segmentsHoveredFrameRect = hoveredFrameRect();
+    m_segmentsDirty = false;
+
+    const int penMargin = s_segmentPenWidth / 2 + 1;
+    auto addSegment = [this, penMargin](DropLocation loc, const QPolygon &polygon) {
+        const QRect boundingRect = polygon.boundingRect().adjusted(-penMargin, -penMargin, penMargin, penMargin);
+        m_segments.push_back({ loc, polygon, boundingRect });
+    };
 
     const auto outterSegments = segmentsForRect(rect(), /*inner=*/false);
 
     for (auto indicator : { DropLocation_OutterLeft, DropLocation_OutterRight, DropLocation_OutterTop, DropLocation_OutterBottom }) {
         if (dropIndicatorVisible(indicator)) {
-            m_segments.insert(indicator, outterSegments.value(indicator));
+            addSegment(indicator, outterSegments.value(indicator));
         }
     }
 
@@ -164,14 +189,38 @@ void SegmentedIndicators::updateSegments()
 
     for (auto indicator : { DropLocation_Left, DropLocation_Top, DropLocation_Right, DropLocation_Bottom, DropLocation_Center }) {
         if (dropIndicatorVisible(indicator)) {
-            m_segments.insert(indicator, innerSegments.value(indicator));
+            addSegment(indicator, innerSegments.value(indicator));
         }
     }
 
     update();
 }
 
-void SegmentedIndicators::drawSegments(QPainter *p)
+void SegmentedIndicators::setHoveredLocation(DropLocation loc)
+{
+    if (loc == m_hoveredLocation)
+        return;
+
+    // Only the segments changing color need repainting
+    if (const Segment *old = segmentForLocation(m_hoveredLocation))
+        update(old->boundingRect);
+    if (const Segment *current = segmentForLocation(loc))
+        update(current->boundingRect);
+
+    m_hoveredLocation = loc;
+}
+
+const SegmentedIndicators::Segment *SegmentedIndicators::segmentForLocation(DropLocation loc) const
+{
+    for (const Segment &segment : m_segments) {
+        if (segment.location == loc)
+            return &segment;
+    }
+
+    return nullptr;
+}
+
+void SegmentedIndicators::drawSegments(QPainter *p, QRect clipRect)
 {
     for (DropLocation loc : { DropLocation_Left,
                               DropLocation_Top,
@@ -181,13 +230,16 @@ void SegmentedIndicators::drawSegments(QPainter *p)
                               DropLocation_OutterLeft,
                               DropLocation_OutterTop,
                               DropLocation_OutterRight,
-                              DropLocation_OutterBottom })
-        drawSegment(p, m_segments.value(loc));
+                              DropLocation_OutterBottom }) {
+        const Segment *segment = segmentForLocation(loc);
+        if (segment && segment->boundingRect.intersects(clipRect))
+            drawSegment(p, *segment);
+    }
 }
 
-void SegmentedIndicators::drawSegment(QPainter *p, const QPolygon &segment)
+void SegmentedIndicators::drawSegment(QPainter *p, const Segment &segment)
 {
-    if (segment.isEmpty())
+    if (segment.polygon.isEmpty())
         return;
 
     QPen pen(s_segmentPenColor);
@@ -195,11 +247,11 @@ void SegmentedIndicators::drawSegment(QPainter *p, const QPolygon &segment)
     p->setPen(pen);
     QColor brush(s_segmentBrushColor);
 
-    if (segment.containsPoint(m_hoveredPt, Qt::OddEvenFill))
+    if (segment.location == m_hoveredLocation)
         brush = s_hoveredSegmentBrushColor;
 
     p->setBrush(brush);
-    p->drawPolygon(segment);
+    p->drawPolygon(segment.polygon);
 }
 
 QPoint KDDockWidgets::SegmentedIndicators::posForIndicator(DropLocation) const
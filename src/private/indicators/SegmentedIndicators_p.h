@@ -16,6 +16,7 @@
 
 #include <QHash>
 #include <QPolygon>
+#include <QVector>
 
 namespace KDDockWidgets {
 
@@ -42,14 +43,30 @@ public:
 protected:
     void paintEvent(QPaintEvent *) override;
     QPoint posForIndicator(DropLocation) const override;
+    void updateVisibility() override;
 
 private:
+    struct Segment
+    {
+        DropLocation location;
+        QPolygon polygon;
+        QRect boundingRect; // Includes the pen, used for hit-testing and partial repaints
+    };
+
     QHash<DropLocation, QPolygon> segmentsForRect(QRect, bool inner, bool useOffset = false) const;
     void updateSegments();
-    void drawSegments(QPainter *p);
-    void drawSegment(QPainter *p, const QPolygon &segment);
-    QPoint m_hoveredPt = {};
-    QHash<DropLocation, QPolygon> m_segments;
+    void ensureSegments();
+    void setHoveredLocation(DropLocation);
+    const Segment *segmentForLocation(DropLocation) const;
+    void drawSegments(QPainter *p, QRect clipRect);
+    void drawSegment(QPainter *p, const Segment &segment);
+    DropLocation m_hoveredLocation = DropLocation_None;
+    QVector<Segment> m_segments;
+
+    // The segments only depend on these, so are only rebuilt when they change
+    QRect m_segmentsRect;
+    QRect m_segmentsHoveredFrameRect;
+    bool m_segmentsDirty = true;
 };
 
 }
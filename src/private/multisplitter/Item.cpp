@@ -17,7 +17,9 @@
 
 #include <QEvent>
 #include <QDebug>
+#include <QMetaMethod>
 #include <QScopedValueRollback>
+#include <QPointer>
 #include <QTimer>
 #include <QGuiApplication>
 #include <QScreen>
@@ -44,6 +46,12 @@ QSize Layouting::Item::hardcodedMaximumSize = QSize(16777215, 16777215);
 
 bool Layouting::ItemBoxContainer::s_inhibitSimplify = false;
 
+#ifdef DOCKS_FULL_SANITY_CHECKS
+bool Layouting::Item::s_fullSanityChecks = true;
+#else
+bool Layouting::Item::s_fullSanityChecks = false;
+#endif
+
 inline bool locationIsVertical(Location loc)
 {
     return loc == Location_OnTop || loc == Location_OnBottom;
@@ -105,10 +113,21 @@ struct LengthOnSide
 
 }
 
+int Layouting::frameInterval(const QScreen *screen)
+{
+    const qreal refreshRate = screen ? screen->refreshRate() : 0;
+    return refreshRate >= 1 ? qMax(1, qRound(1000 / refreshRate)) : 16;
+}
+
 ItemBoxContainer *Item::root() const
 {
-    return m_parent ? m_parent->root()
-                    : const_cast<ItemBoxContainer *>(qobject_cast<const ItemBoxContainer *>(this));
+    return qobject_cast<ItemBoxContainer *>(rootContainer());
+}
+
+ItemContainer *Item::rootContainer() const
+{
+    return m_parent ? m_parent->rootContainer()
+                    : const_cast<ItemContainer *>(asContainer());
 }
 
 QRect Item::mapToRoot(QRect r) const
@@ -183,6 +202,7 @@ void Item::setGuestWidget(Widget *guest)
     }
 
     m_guest = guest;
+    markSanityDirty();
 
     if (m_guest) {
         m_guest->setParent(m_hostWidget);
@@ -318,19 +338,14 @@ QVector<int> Item::pathFromRoot() const
     // [] would mean 'this' is the root item
     // [0] would mean the 1st child of root
 
-    QVector<int> path;
-    path.reserve(10); // random big number, good to bootstrap it
+    int depth = 0;
+    for (const Item *it = this; it->parentContainer(); it = it->parentContainer())
+        ++depth;
 
-    const Item *it = this;
-    while (it) {
-        if (auto p = it->parentContainer()) {
-            const auto index = p->childItems().indexOf(const_cast<Item *>(it));
-            path.prepend(index);
-            it = p;
-        } else {
-            break;
-        }
-    }
+    // Filled from the back, so there's a single allocation
+    QVector<int> path(depth);
+    for (const Item *it = this; depth > 0; it = it->parentContainer())
+        path[--depth] = it->parentContainer()->m_children.indexOf(const_cast<Item *>(it));
 
     return path;
 }
@@ -339,6 +354,7 @@ void Item::setHostWidget(Widget *host)
 {
     if (m_hostWidget != host) {
         m_hostWidget = host;
+        markSanityDirty();
         if (m_guest) {
             m_guest->setParent(host);
             m_guest->setVisible(true);
@@ -386,6 +402,8 @@ void Item::setParentContainer(ItemContainer *parent)
     if (parent == m_parent)
         return;
 
+    markSanityDirty(); // The old parent has one child less
+
     if (m_parent) {
         disconnect(this, &Item::minSizeChanged, m_parent, &ItemContainer::onChildMinSizeChanged);
         disconnect(this, &Item::visibleChanged, m_parent, &ItemContainer::onChildVisibleChanged);
@@ -410,6 +428,7 @@ void Item::setParentContainer(ItemContainer *parent)
 void Item::connectParent(ItemContainer *parent)
 {
     if (parent) {
+        markSanityDirty();
         connect(this, &Item::minSizeChanged, parent, &ItemContainer::onChildMinSizeChanged);
         connect(this, &Item::visibleChanged, parent, &ItemContainer::onChildVisibleChanged);
 
@@ -449,6 +468,7 @@ void Item::setMinSize(QSize sz)
 {
     if (sz != m_sizingInfo.minSize) {
         m_sizingInfo.minSize = sz;
+        markSanityDirty();
         Q_EMIT minSizeChanged(this);
         if (!m_isSettingGuest)
             setSize_recursive(size().expandedTo(sz));
@@ -459,6 +479,7 @@ void Item::setMaxSizeHint(QSize sz)
 {
     if (sz != m_sizingInfo.maxSizeHint) {
         m_sizingInfo.maxSizeHint = sz;
+        markSanityDirty();
         Q_EMIT maxSizeChanged(this);
     }
 }
@@ -598,6 +619,7 @@ void Item::setIsVisible(bool is)
 {
     if (is != m_isVisible) {
         m_isVisible = is;
+        markSanityDirty();
         Q_EMIT visibleChanged(this, is);
     }
 
@@ -664,6 +686,24 @@ bool Item::checkSanity()
     return true;
 }
 
+void Item::markSanityDirty()
+{
+    m_sanityDirty = true;
+
+    Item *ancestor = m_parent;
+    if (ancestor)
+        ancestor->m_sanityDirty = true;
+
+    // Stop at the first ancestor that already knows, as its own ancestors know too
+    while (ancestor && (ancestor = ancestor->m_parent) && !ancestor->m_hasDirtyDescendants)
+        ancestor->m_hasDirtyDescendants = true;
+}
+
+bool Item::needsSanityCheck() const
+{
+    return s_fullSanityChecks || m_sanityDirty || m_hasDirtyDescendants;
+}
+
 bool Item::isMDI() const
 {
     return qobject_cast<ItemFreeContainer *>(parentContainer()) != nullptr;
@@ -677,6 +717,17 @@ void Item::setGeometry(QRect rect)
         const QRect oldGeo = m_geometry;
 
         m_geometry = rect;
+        markSanityDirty();
+
+        if (oldGeo.topLeft() != rect.topLeft()) {
+            // Descendants keep their local geometry but their guests move, so validate them again
+            if (ItemContainer *c = asContainer()) {
+                c->forEachLeaf([](Item *item) {
+                    item->markSanityDirty();
+                    return true;
+                });
+            }
+        }
 
         if (rect.isEmpty()) {
             // Just a sanity check...
@@ -712,6 +763,12 @@ void Item::setGeometry(QRect rect)
         if (oldGeo.height() != height())
             Q_EMIT heightChanged();
 
+        static const QMetaMethod descendantGeometryChangedSignal =
+            QMetaMethod::fromSignal(&ItemContainer::descendantGeometryChanged);
+        ItemContainer *r = rootContainer();
+        if (r && r->isSignalConnected(descendantGeometryChangedSignal))
+            Q_EMIT r->descendantGeometryChanged();
+
         updateWidgetGeometries();
     }
 }
@@ -819,6 +876,23 @@ void Item::onWidgetDestroyed()
 }
 
 void Item::onWidgetLayoutRequested()
+{
+    if (!guestWidget())
+        return;
+
+    if (Config::self().flags() & Config::Flag::CoalesceLayoutRequests) {
+        // Guests rebuilding their contents can request dozens of layouts per event loop turn.
+        // Queue them in the root, which applies each item's constraints only once per frame.
+        if (ItemContainer *r = rootContainer()) {
+            r->d->queueLayoutRequest(this);
+            return;
+        }
+    }
+
+    updateSizeConstraintsFromGuest();
+}
+
+void Item::updateSizeConstraintsFromGuest()
 {
     if (Widget *w = guestWidget()) {
         if (w->size() != size() && !isMDI()) { // for MDI we allow user/manual arbitrary resize with mouse
@@ -948,7 +1022,27 @@ struct ItemBoxContainer::Private
     bool isDummy() const;
     void deleteSeparators_recursive();
     void updateSeparators_recursive();
-    QSize minSize(const Item::List &items) const;
+    template <typename Items>
+    QSize minSize(const Items &items) const;
+
+    /// Calls @p func for each visible child on @p side of @p item, without allocating
+    /// Returns false if @p item isn't a visible child.
+    template <typename Func>
+    bool forEachVisibleNeighbour(const Item *item, Side side, Func func) const
+    {
+        bool found = false;
+        for (Item *child : q->visibleChildrenView()) {
+            if (child == item) {
+                found = true;
+                if (side == Side1)
+                    break;
+            } else if (found == (side == Side2)) {
+                func(child);
+            }
+        }
+
+        return found;
+    }
     int excessLength() const;
 
     mutable bool m_checkSanityScheduled = false;
@@ -1014,6 +1108,11 @@ bool ItemBoxContainer::checkSanity()
         return true;
     }
 
+    if (!needsSanityCheck()) {
+        // Nothing changed since the last successful check
+        return true;
+    }
+
     if (!Item::checkSanity())
         return false;
 
@@ -1077,8 +1176,13 @@ bool ItemBoxContainer::checkSanity()
             }
         }
 
-        if (!item->checkSanity())
-            return false;
+        // Only descend into what changed. Our own invariants above are always checked, as they
+        // aggregate our children's.
+        if (item->needsSanityCheck()) {
+            if (!item->checkSanity())
+                return false;
+            item->m_sanityDirty = false;
+        }
     }
 
     const Item::List visibleChildren = this->visibleChildren();
@@ -1193,6 +1297,9 @@ bool ItemBoxContainer::checkSanity()
     }
 #endif
 
+    m_sanityDirty = false;
+    m_hasDirtyDescendants = false;
+
     return true;
 }
 
@@ -1211,8 +1318,7 @@ bool ItemBoxContainer::hasOrientation() const
 
 int ItemBoxContainer::indexOfVisibleChild(const Item *item) const
 {
-    const Item::List items = visibleChildren();
-    return items.indexOf(const_cast<Item *>(item));
+    return visibleChildrenView().indexOf(item);
 }
 
 void ItemBoxContainer::restore(Item *child)
@@ -1601,12 +1707,10 @@ void ItemBoxContainer::positionItems_recursive()
 
 void ItemBoxContainer::applyPositions(const SizingInfo::List &sizes)
 {
-    const Item::List items = visibleChildren();
-    const auto count = items.size();
-    Q_ASSERT(count == sizes.size());
-    for (int i = 0; i < count; ++i) {
-        Item *item = items.at(i);
-        const SizingInfo &sizing = sizes[i];
+    Q_ASSERT(visibleChildrenView().size() == sizes.size());
+    int i = 0;
+    for (Item *item : visibleChildrenView()) {
+        const SizingInfo &sizing = sizes[i++];
         if (sizing.isBeingInserted) {
             continue;
         }
@@ -1656,6 +1760,7 @@ void ItemBoxContainer::clear()
     }
     m_children.clear();
     d->deleteSeparators();
+    markSanityDirty();
 }
 
 Item *ItemBoxContainer::itemAt(QPoint p) const
@@ -1750,10 +1855,9 @@ bool ItemBoxContainer::hasOrientationFor(Location loc) const
 
 int ItemBoxContainer::usableLength() const
 {
-    const Item::List children = visibleChildren();
-    const auto numVisibleChildren = children.size();
+    const int numVisibleChildren = visibleChildrenView().size();
 
-    if (children.size() <= 1)
+    if (numVisibleChildren <= 1)
         return Layouting::length(size(), d->m_orientation);
 
     const int separatorWaste = separatorThickness * (numVisibleChildren - 1);
@@ -1777,7 +1881,8 @@ void ItemBoxContainer::setOrientation(Qt::Orientation o)
     }
 }
 
-QSize ItemBoxContainer::Private::minSize(const Item::List &items) const
+template <typename Items>
+QSize ItemBoxContainer::Private::minSize(const Items &items) const
 {
     int minW = 0;
     int minH = 0;
@@ -1816,9 +1921,11 @@ QSize ItemBoxContainer::maxSizeHint() const
     int maxW = isVertical() ? hardcodedMaximumSize.width() : 0;
     int maxH = isVertical() ? 0 : hardcodedMaximumSize.height();
 
-    const Item::List visibleChildren = this->visibleChildren(/*includeBeingInserted=*/false);
+    const VisibleItemsView visibleChildren = visibleChildrenView(/*includeBeingInserted=*/false);
     if (!visibleChildren.isEmpty()) {
+        int numVisibleChildren = 0;
         for (Item *item : visibleChildren) {
+            numVisibleChildren++;
             if (item->isBeingInserted())
                 continue;
             const QSize itemMaxSz = item->maxSizeHint();
@@ -1833,7 +1940,7 @@ QSize ItemBoxContainer::maxSizeHint() const
             }
         }
 
-        const auto separatorWaste = (visibleChildren.size() - 1) * separatorThickness;
+        const auto separatorWaste = (numVisibleChildren - 1) * separatorThickness;
         if (isVertical()) {
             maxH = qMin(maxH + separatorWaste, hardcodedMaximumSize.height());
         } else {
@@ -2047,9 +2154,8 @@ void ItemBoxContainer::setSize_recursive(QSize newSize, ChildrenResizeStrategy s
     const QSize oldSize = size();
     setSize(newSize);
 
-    const Item::List children = visibleChildren();
-    const auto count = children.size();
     SizingInfo::List childSizes = sizes();
+    const auto count = childSizes.size();
 
     // #1 Since we changed size, also resize out children.
     // But apply them to our SizingInfo::List first before setting actual Item/QWidget geometries
@@ -2267,8 +2373,10 @@ void ItemBoxContainer::requestSeparatorMove(Separator *separator, int delta)
     }
 
     const Side moveDirection = delta < 0 ? Side1 : Side2;
-    const Item::List children = visibleChildren();
-    if (children.size() <= separatorIndex) {
+    const VisibleItemsView children = visibleChildrenView();
+    Item *side1Neighbour = children.at(separatorIndex);
+    Item *side2Neighbour = children.at(separatorIndex + 1);
+    if (!side1Neighbour || !side2Neighbour) {
         // Doesn't happen
         qWarning() << Q_FUNC_INFO << "Not enough children for separator index" << separator
                    << this << separatorIndex;
@@ -2279,9 +2387,6 @@ void ItemBoxContainer::requestSeparatorMove(Separator *separator, int delta)
     int remainingToTake = qAbs(delta);
     int tookLocally = 0;
 
-    Item *side1Neighbour = children[separatorIndex];
-    Item *side2Neighbour = children[separatorIndex + 1];
-
     Side nextSeparatorDirection = moveDirection;
 
     if (moveDirection == Side1) {
@@ -2353,7 +2458,7 @@ void ItemBoxContainer::requestEqualSize(Separator *separator)
         return;
     }
 
-    const Item::List children = visibleChildren();
+    const VisibleItemsView children = visibleChildrenView();
     Item *side1Item = children.at(separatorIndex);
     Item *side2Item = children.at(separatorIndex + 1);
 
@@ -2554,33 +2659,20 @@ LengthOnSide ItemBoxContainer::lengthOnSide(const SizingInfo::List &sizes, int f
 
 int ItemBoxContainer::neighboursLengthFor(const Item *item, Side side, Qt::Orientation o) const
 {
-    const Item::List children = visibleChildren();
-    const auto index = children.indexOf(const_cast<Item *>(item));
-    if (index == -1) {
+    // No neighbours in the other orientation. Each container is bidimensional.
+    const bool sameOrientation = o == d->m_orientation;
+    int neighbourLength = 0;
+    const bool found = d->forEachVisibleNeighbour(item, side, [&](const Item *neighbour) {
+        if (sameOrientation)
+            neighbourLength += neighbour->length(o);
+    });
+
+    if (!found) {
         qWarning() << Q_FUNC_INFO << "Couldn't find item" << item;
         return 0;
     }
 
-    if (o == d->m_orientation) {
-        int neighbourLength = 0;
-        int start = 0;
-        int end = -1;
-        if (side == Side1) {
-            start = 0;
-            end = index - 1;
-        } else {
-            start = index + 1;
-            end = children.size() - 1;
-        }
-
-        for (int i = start; i <= end; ++i)
-            neighbourLength += children.at(i)->length(d->m_orientation);
-
-        return neighbourLength;
-    } else {
-        // No neighbours in the other orientation. Each container is bidimensional.
-        return 0;
-    }
+    return neighbourLength;
 }
 
 int ItemBoxContainer::neighboursLengthFor_recursive(const Item *item, Side side, Qt::Orientation o) const
@@ -2590,64 +2682,38 @@ int ItemBoxContainer::neighboursLengthFor_recursive(const Item *item, Side side,
 
 int ItemBoxContainer::neighboursMinLengthFor(const Item *item, Side side, Qt::Orientation o) const
 {
-    const Item::List children = visibleChildren();
-    const auto index = children.indexOf(const_cast<Item *>(item));
-    if (index == -1) {
+    // No neighbours in the other orientation. Each container is bidimensional.
+    const bool sameOrientation = o == d->m_orientation;
+    int neighbourMinLength = 0;
+    const bool found = d->forEachVisibleNeighbour(item, side, [&](const Item *neighbour) {
+        if (sameOrientation)
+            neighbourMinLength += neighbour->minLength(o);
+    });
+
+    if (!found) {
         qWarning() << Q_FUNC_INFO << "Couldn't find item" << item;
         return 0;
     }
 
-    if (o == d->m_orientation) {
-        int neighbourMinLength = 0;
-        int start = 0;
-        int end = -1;
-        if (side == Side1) {
-            start = 0;
-            end = index - 1;
-        } else {
-            start = index + 1;
-            end = children.size() - 1;
-        }
-
-        for (int i = start; i <= end; ++i)
-            neighbourMinLength += children.at(i)->minLength(d->m_orientation);
-
-        return neighbourMinLength;
-    } else {
-        // No neighbours here
-        return 0;
-    }
+    return neighbourMinLength;
 }
 
 int ItemBoxContainer::neighboursMaxLengthFor(const Item *item, Side side, Qt::Orientation o) const
 {
-    const Item::List children = visibleChildren();
-    const auto index = children.indexOf(const_cast<Item *>(item));
-    if (index == -1) {
+    // No neighbours in the other orientation. Each container is bidimensional.
+    const bool sameOrientation = o == d->m_orientation;
+    int neighbourMaxLength = 0;
+    const bool found = d->forEachVisibleNeighbour(item, side, [&](const Item *neighbour) {
+        if (sameOrientation)
+            neighbourMaxLength = qMin(Layouting::length(root()->size(), o), neighbourMaxLength + neighbour->maxLengthHint(o));
+    });
+
+    if (!found) {
         qWarning() << Q_FUNC_INFO << "Couldn't find item" << item;
         return 0;
     }
 
-    if (o == d->m_orientation) {
-        int neighbourMaxLength = 0;
-        int start = 0;
-        int end = -1;
-        if (side == Side1) {
-            start = 0;
-            end = index - 1;
-        } else {
-            start = index + 1;
-            end = children.size() - 1;
-        }
-
-        for (int i = start; i <= end; ++i)
-            neighbourMaxLength = qMin(Layouting::length(root()->size(), d->m_orientation), neighbourMaxLength + children.at(i)->maxLengthHint(d->m_orientation));
-
-        return neighbourMaxLength;
-    } else {
-        // No neighbours here
-        return 0;
-    }
+    return neighbourMaxLength;
 }
 
 int ItemBoxContainer::availableToSqueezeOnSide(const Item *child, Side side) const
@@ -2871,8 +2937,7 @@ void ItemBoxContainer::growItem(Item *item, int amount, GrowthStrategy growthStr
                                 bool accountForNewSeparator,
                                 ChildrenResizeStrategy childResizeStrategy)
 {
-    const Item::List items = visibleChildren();
-    const auto index = items.indexOf(item);
+    const auto index = visibleChildrenView().indexOf(item);
     SizingInfo::List sizes = this->sizes();
 
     growItem(index, /*by-ref=*/sizes, amount, growthStrategy, neighbourSqueezeStrategy, accountForNewSeparator);
@@ -2882,23 +2947,20 @@ void ItemBoxContainer::growItem(Item *item, int amount, GrowthStrategy growthStr
 
 void ItemBoxContainer::applyGeometries(const SizingInfo::List &sizes, ChildrenResizeStrategy strategy)
 {
-    const Item::List items = visibleChildren();
-    const auto count = items.size();
-    Q_ASSERT(count == sizes.size());
+    Q_ASSERT(visibleChildrenView().size() == sizes.size());
 
-    for (int i = 0; i < count; ++i) {
-        Item *item = items.at(i);
-        item->setSize_recursive(sizes[i].geometry.size(), strategy);
-    }
+    int i = 0;
+    for (Item *item : visibleChildrenView())
+        item->setSize_recursive(sizes[i++].geometry.size(), strategy);
 
     positionItems();
 }
 
 SizingInfo::List ItemBoxContainer::sizes(bool ignoreBeingInserted) const
 {
-    const Item::List children = visibleChildren(ignoreBeingInserted);
+    const VisibleItemsView children = visibleChildrenView(ignoreBeingInserted);
     SizingInfo::List result;
-    result.reserve(children.count());
+    result.reserve(m_children.count());
     for (Item *item : children) {
         if (item->isContainer()) {
             // Containers have virtual min/maxSize methods, and don't really fill in these properties
@@ -3038,11 +3100,12 @@ void ItemBoxContainer::Private::updateSeparators()
     if (!q->hostWidget())
         return;
 
-    const QVector<int> positions = requiredSeparatorPositions();
-    const auto requiredNumSeparators = positions.size();
+    const int requiredNumSeparators = qMax(0, q->numVisibleChildren() - 1);
 
     const bool numSeparatorsChanged = requiredNumSeparators != m_separators.size();
     if (numSeparatorsChanged) {
+        const QVector<int> positions = requiredSeparatorPositions();
+
         // Instead of just creating N missing ones at the end of the list, let's minimize separators
         // having their position changed, to minimize flicker
         Separator::List newSeparators;
@@ -3067,17 +3130,24 @@ void ItemBoxContainer::Private::updateSeparators()
         m_separators = newSeparators;
     }
 
-    // Update their positions:
+    // Update their positions. Same as requiredSeparatorPositions(), but without allocating:
     const int pos2 = q->isVertical() ? q->mapToRoot(QPoint(0, 0)).x()
                                      : q->mapToRoot(QPoint(0, 0)).y();
 
     int i = 0;
-    for (int position : positions) {
-        m_separators.at(i)->setGeometry(position, pos2, q->oppositeLength());
-        i++;
+    for (Item *item : qAsConst(q->m_children)) {
+        if (i == requiredNumSeparators)
+            break;
+
+        if (item->isVisible()) {
+            const int position = q->mapToRoot(item->m_sizingInfo.edge(m_orientation) + 1, m_orientation);
+            m_separators.at(i)->setGeometry(position, pos2, q->oppositeLength());
+            i++;
+        }
     }
 
     q->updateChildPercentages();
+    q->markSanityDirty();
 }
 
 void ItemBoxContainer::Private::deleteSeparators()
@@ -3102,8 +3172,7 @@ void ItemBoxContainer::Private::updateSeparators_recursive()
     updateSeparators();
 
     // recurse into the children:
-    const Item::List items = q->visibleChildren();
-    for (Item *item : items) {
+    for (Item *item : q->visibleChildrenView()) {
         if (auto c = item->asBoxContainer())
             c->d->updateSeparators_recursive();
     }
@@ -3204,9 +3273,9 @@ int ItemBoxContainer::minPosForSeparator_global(Separator *separator, bool honou
     const int separatorIndex = indexOf(separator);
     Q_ASSERT(separatorIndex != -1);
 
-    const Item::List children = visibleChildren();
-    Q_ASSERT(separatorIndex + 1 < children.size());
+    const VisibleItemsView children = visibleChildrenView();
     Item *item2 = children.at(separatorIndex + 1);
+    Q_ASSERT(item2);
 
     const int availableToSqueeze = availableToSqueezeOnSide_recursive(item2, Side1, d->m_orientation);
 
@@ -3225,8 +3294,9 @@ int ItemBoxContainer::maxPosForSeparator_global(Separator *separator, bool honou
     const int separatorIndex = indexOf(separator);
     Q_ASSERT(separatorIndex != -1);
 
-    const Item::List children = visibleChildren();
+    const VisibleItemsView children = visibleChildrenView();
     Item *item1 = children.at(separatorIndex);
+    Q_ASSERT(item1);
 
     const int availableToSqueeze = availableToSqueezeOnSide_recursive(item1, Side2, d->m_orientation);
 
@@ -3337,12 +3407,10 @@ bool ItemBoxContainer::test_suggestedRect()
 
 QVector<Separator *> ItemBoxContainer::separators_recursive() const
 {
-    Layouting::Separator::List separators = d->m_separators;
-
-    for (Item *item : qAsConst(m_children)) {
-        if (auto c = item->asBoxContainer())
-            separators << c->separators_recursive();
-    }
+    Layouting::Separator::List separators;
+    forEachSeparator_recursive([&separators](Separator *separator) {
+        separators.push_back(separator);
+    });
 
     return separators;
 }
@@ -3426,8 +3494,7 @@ const Item *ItemBoxContainer::Private::itemFromPath(const QVector<int> &path) co
 
 Separator *ItemBoxContainer::Private::neighbourSeparator(const Item *item, Side side, Qt::Orientation orientation) const
 {
-    Item::List children = q->visibleChildren();
-    const auto itemIndex = children.indexOf(const_cast<Item *>(item));
+    const auto itemIndex = q->visibleChildrenView().indexOf(item);
     if (itemIndex == -1) {
         qWarning() << Q_FUNC_INFO << "Item not found" << item
                    << this;
@@ -3555,9 +3622,59 @@ struct ItemContainer::Private
     ~Private()
     {
     }
+
+    void queueLayoutRequest(Item *);
+
     ItemContainer *const q;
+
+    // For Config::Flag::CoalesceLayoutRequests. Only used by the root container.
+    QVector<QPointer<Item>> m_pendingLayoutRequests;
+    QTimer *m_layoutRequestTimer = nullptr;
+    int m_numCoalescedLayoutRequests = 0;
 };
 
+void ItemContainer::Private::queueLayoutRequest(Item *item)
+{
+    if (m_pendingLayoutRequests.contains(item)) {
+        m_numCoalescedLayoutRequests++;
+        return;
+    }
+
+    m_pendingLayoutRequests.push_back(item);
+
+    if (!m_layoutRequestTimer) {
+        m_layoutRequestTimer = new QTimer(q);
+        m_layoutRequestTimer->setSingleShot(true);
+        QObject::connect(m_layoutRequestTimer, &QTimer::timeout, q, &ItemContainer::applyPendingLayoutRequests);
+    }
+
+    if (!m_layoutRequestTimer->isActive()) {
+        m_layoutRequestTimer->setInterval(frameInterval(QGuiApplication::primaryScreen()));
+        m_layoutRequestTimer->start();
+    }
+}
+
+int ItemContainer::numCoalescedLayoutRequests() const
+{
+    return d->m_numCoalescedLayoutRequests;
+}
+
+void ItemContainer::applyPendingLayoutRequests()
+{
+    if (d->m_layoutRequestTimer)
+        d->m_layoutRequestTimer->stop();
+
+    // Applying constraints can make guests request layouts again, those go into the next batch
+    const QVector<QPointer<Item>> pending = std::move(d->m_pendingLayoutRequests);
+    d->m_pendingLayoutRequests.clear();
+
+    for (const QPointer<Item> &item : pending) {
+        // The item might have been deleted or lost its guest meanwhile
+        if (item)
+            item->updateSizeConstraintsFromGuest();
+    }
+}
+
 ItemContainer::ItemContainer(Widget *hostWidget, ItemContainer *parent)
     : Item(true, hostWidget, parent)
     , d(new Private(this))
@@ -3669,15 +3786,8 @@ Item::List ItemContainer::visibleChildren(bool includeBeingInserted) const
 {
     Item::List items;
     items.reserve(m_children.size());
-    for (Item *item : qAsConst(m_children)) {
-        if (includeBeingInserted) {
-            if (item->isVisible() || item->isBeingInserted())
-                items << item;
-        } else {
-            if (item->isVisible() && !item->isBeingInserted())
-                items << item;
-        }
-    }
+    for (Item *item : visibleChildrenView(includeBeingInserted))
+        items << item;
 
     return items;
 }
@@ -3686,13 +3796,10 @@ Item::List ItemContainer::items_recursive() const
 {
     Item::List items;
     items.reserve(30); // sounds like a good upper number to minimize allocations
-    for (Item *item : qAsConst(m_children)) {
-        if (auto c = item->asContainer()) {
-            items << c->items_recursive();
-        } else {
-            items << item;
-        }
-    }
+    forEachLeaf([&items](Item *item) {
+        items << item;
+        return true;
+    });
 
     return items;
 }
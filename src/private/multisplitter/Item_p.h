@@ -20,9 +20,13 @@
 #include <QVariant>
 #include <QDebug>
 
+#include <algorithm>
 #include <memory>
 
 class TestMultiSplitter;
+QT_BEGIN_NAMESPACE
+class QScreen;
+QT_END_NAMESPACE
 
 namespace Layouting {
 Q_NAMESPACE
@@ -30,6 +34,7 @@ Q_NAMESPACE
 class ItemContainer;
 class ItemBoxContainer;
 class Item;
+struct VisibleItemPredicate;
 class Separator;
 class Widget;
 struct LengthOnSide;
@@ -89,6 +94,9 @@ inline int length(QSize sz, Qt::Orientation o)
                              : sz.width();
 }
 
+/// @brief Returns the duration of a display frame on @p screen, in ms. 16 if unknown.
+int frameInterval(const QScreen *screen);
+
 inline QVariantMap sizeToMap(QSize sz)
 {
     QVariantMap map;
@@ -270,6 +278,14 @@ public:
     static QSize hardcodedMaximumSize;
     static int separatorThickness;
 
+    /**
+     * @brief If true, checkSanity() validates the whole tree every time.
+     *
+     * Otherwise only the subtrees which changed since the last successful check are validated,
+     * plus their ancestors' own invariants. Defaults to true if built with DOCKS_FULL_SANITY_CHECKS.
+     */
+    static bool s_fullSanityChecks;
+
     int x() const;
     int y() const;
     int width() const;
@@ -288,6 +304,8 @@ public:
     bool isPlaceholder() const;
     void setGeometry(QRect rect);
     ItemBoxContainer *root() const;
+    /// @brief Like root(), but also returns the top-level container when it's not a box container (MDI)
+    ItemContainer *rootContainer() const;
     QRect mapToRoot(QRect) const;
     QPoint mapToRoot(QPoint) const;
     int mapToRoot(int p, Qt::Orientation) const;
@@ -368,22 +386,156 @@ protected:
     const bool m_isContainer;
     ItemContainer *m_parent = nullptr;
     bool m_isSettingGuest = false;
+
+    /// @brief Marks this item as needing to be validated by the next checkSanity()
+    /// Its parent is marked too, as it validates its children's geometries, and the remaining ancestors
+    /// are told that they have something to validate below them.
+    void markSanityDirty();
+
+    /// @brief Returns whether checkSanity() needs to validate this item or anything below it
+    bool needsSanityCheck() const;
 private Q_SLOTS:
     void onWidgetLayoutRequested();
 
+private:
+    void updateSizeConstraintsFromGuest();
+
 private:
     friend class ItemContainer;
     friend class ItemBoxContainer;
     friend class ItemFreeContainer;
+    friend struct VisibleItemPredicate;
     bool eventFilter(QObject *o, QEvent *event) override;
     int m_refCount = 0;
     void updateObjectName();
     void onWidgetDestroyed();
     bool m_isVisible = false;
+    bool m_sanityDirty = true;
+    bool m_hasDirtyDescendants = false;
     Widget *m_hostWidget = nullptr;
     Widget *m_guest = nullptr;
 };
 
+/// @brief A read-only view over a list of items, yielding only those accepted by @p Predicate
+///
+/// Allows range-for loops and index lookups over a filtered list without allocating a temporary one.
+/// The view references the list, which must not be modified while the view is in use.
+template <typename Predicate>
+class ItemFilterView
+{
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator(Item::List::const_iterator it, Item::List::const_iterator end, const Predicate *predicate)
+            : m_it(it)
+            , m_end(end)
+            , m_predicate(predicate)
+        {
+            skipRejected();
+        }
+
+        Item *operator*() const
+        {
+            return *m_it;
+        }
+
+        const_iterator &operator++()
+        {
+            ++m_it;
+            skipRejected();
+            return *this;
+        }
+
+        bool operator==(const const_iterator &other) const
+        {
+            return m_it == other.m_it;
+        }
+
+        bool operator!=(const const_iterator &other) const
+        {
+            return m_it != other.m_it;
+        }
+
+    private:
+        void skipRejected()
+        {
+            while (m_it != m_end && !(*m_predicate)(*m_it))
+                ++m_it;
+        }
+
+        Item::List::const_iterator m_it;
+        Item::List::const_iterator m_end;
+        const Predicate *m_predicate;
+    };
+
+    ItemFilterView(const Item::List &items, Predicate predicate)
+        : m_items(items)
+        , m_predicate(predicate)
+    {
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(m_items.cbegin(), m_items.cend(), &m_predicate);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(m_items.cend(), m_items.cend(), &m_predicate);
+    }
+
+    bool isEmpty() const
+    {
+        return begin() == end();
+    }
+
+    int size() const
+    {
+        return int(std::count_if(m_items.cbegin(), m_items.cend(), m_predicate));
+    }
+
+    ///@brief Returns the index of @p item in the view, or -1
+    int indexOf(const Item *item) const
+    {
+        int index = 0;
+        for (const Item *it : *this) {
+            if (it == item)
+                return index;
+            ++index;
+        }
+        return -1;
+    }
+
+    ///@brief Returns the item at @p index in the view, or nullptr. Linear, as the view isn't materialized.
+    Item *at(int index) const
+    {
+        for (Item *it : *this) {
+            if (index-- == 0)
+                return it;
+        }
+        return nullptr;
+    }
+
+private:
+    const Item::List &m_items;
+    const Predicate m_predicate;
+};
+
+/// @brief The predicate used by ItemContainer::visibleChildrenView()
+struct VisibleItemPredicate
+{
+    bool operator()(const Item *item) const
+    {
+        return includeBeingInserted ? (item->isVisible() || item->isBeingInserted())
+                                    : (item->isVisible() && !item->isBeingInserted());
+    }
+
+    bool includeBeingInserted;
+};
+
+typedef ItemFilterView<VisibleItemPredicate> VisibleItemsView;
+
 /// @brief And Item which can contain other Items
 class DOCKS_EXPORT_FOR_UNIT_TESTS ItemContainer : public Item
 {
@@ -409,6 +561,36 @@ public:
     Item *itemForWidget(const Widget *w) const;
     Item::List visibleChildren(bool includeBeingInserted = false) const;
     Item::List items_recursive() const;
+
+    /// @brief Like visibleChildren() but doesn't allocate. Don't add or remove children while using it
+    VisibleItemsView visibleChildrenView(bool includeBeingInserted = false) const
+    {
+        return VisibleItemsView(m_children, { includeBeingInserted });
+    }
+
+    /// @brief Calls @p func for each visible child, without allocating a list of them
+    template <typename Func>
+    void forEachVisibleChild(Func &&func, bool includeBeingInserted = false) const
+    {
+        for (Item *item : visibleChildrenView(includeBeingInserted))
+            func(item);
+    }
+
+    /// @brief Calls @p func for each non-container item in this subtree, in the same order as items_recursive()
+    /// @p func returns false to stop the traversal early, in which case this returns false too.
+    /// Doesn't allocate. Don't add or remove items while traversing.
+    template <typename Func>
+    bool forEachLeaf(Func &&func) const
+    {
+        for (Item *item : m_children) {
+            const bool keepGoing = item->isContainer() ? static_cast<const ItemContainer *>(item)->forEachLeaf(func)
+                                                       : func(item);
+            if (!keepGoing)
+                return false;
+        }
+
+        return true;
+    }
     bool contains_recursive(const Item *item) const;
     int visibleCount_recursive() const override;
     int count_recursive() const;
@@ -424,7 +606,20 @@ Q_SIGNALS:
     void numVisibleItemsChanged(int);
     void numItemsChanged();
 
+    /// @brief Emitted by the root container whenever any item of the tree changes geometry
+    /// So listeners don't need to connect to every item's geometryChanged()
+    void descendantGeometryChanged();
+
+public:
+    /// @brief Returns how many guest layout requests were merged into an already pending one
+    /// Only meaningful for the root container and with Config::Flag::CoalesceLayoutRequests. For diagnostics.
+    int numCoalescedLayoutRequests() const;
+
+    /// @brief Applies the pending guest layout requests now, instead of waiting for the next frame
+    void applyPendingLayoutRequests();
+
 private:
+    friend class Item;
     struct Private;
     Private *const d;
 };
@@ -561,6 +756,21 @@ public:
     QVector<Layouting::Separator *> separators_recursive() const;
     QVector<Layouting::Separator *> separators() const;
 
+    /// @brief Calls @p func for each separator in this subtree, in the same order as separators_recursive()
+    /// Doesn't allocate.
+    template <typename Func>
+    void forEachSeparator_recursive(Func &&func) const
+    {
+        const QVector<Layouting::Separator *> ownSeparators = separators(); // Implicitly shared, no copy
+        for (Layouting::Separator *separator : ownSeparators)
+            func(separator);
+
+        for (Item *item : m_children) {
+            if (auto c = qobject_cast<const ItemBoxContainer *>(item))
+                c->forEachSeparator_recursive(func);
+        }
+    }
+
 private:
     void simplify();
     static bool s_inhibitSimplify;
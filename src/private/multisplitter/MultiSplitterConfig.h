@@ -27,7 +27,8 @@ class DOCKS_EXPORT_FOR_UNIT_TESTS Config
 public:
     enum class Flag {
         None = 0,
-        LazyResize = 1
+        LazyResize = 1,
+        CoalesceLayoutRequests = 2 ///< Guest size constraint changes are applied once per display frame
     };
     Q_DECLARE_FLAGS(Flags, Flag)
 
@@ -15,6 +15,7 @@
 #include "Item_p.h"
 #include "MultiSplitterConfig.h"
 #include "Config.h"
+#include "LayoutUndoStack.h"
 
 #include <QGuiApplication>
 
@@ -51,6 +52,15 @@ struct Separator::Private
     {
     }
 
+    // Only records an undo step once the separator really moves, a press alone doesn't change anything
+    void beginUndoOperation()
+    {
+        if (!undoOperationStarted) {
+            undoOperationStarted = true;
+            KDDockWidgets::LayoutUndoStack::self()->beginOperation();
+        }
+    }
+
     Qt::Orientation orientation = Qt::Horizontal;
     QRect geometry;
     int lazyPosition = 0;
@@ -58,6 +68,7 @@ struct Separator::Private
     Widget *lazyResizeRubberBand = nullptr;
     ItemBoxContainer *parentContainer = nullptr;
     Layouting::Side lastMoveDirection = Side1;
+    bool undoOperationStarted = false;
     const bool usesLazyResize = Config::self().flags() & Config::Flag::LazyResize;
     Widget *const m_hostWidget;
 };
@@ -71,9 +82,14 @@ Separator::Separator(Widget *hostWidget)
 Separator::~Separator()
 {
     s_numSeparators--;
+    const bool undoOperationStarted = d->undoOperationStarted;
     delete d;
-    if (isBeingDragged())
+    if (isBeingDragged()) {
+        // Deleted mid-drag, record what was done so far
         s_separatorBeingDragged = nullptr;
+        if (undoOperationStarted)
+            KDDockWidgets::LayoutUndoStack::self()->endOperation();
+    }
 }
 
 bool Separator::isVertical() const
@@ -102,6 +118,7 @@ Qt::Orientation Separator::orientation() const
 void Separator::onMousePress()
 {
     s_separatorBeingDragged = this;
+    d->undoOperationStarted = false;
 
     qCDebug(separators) << "Drag started";
 
@@ -162,20 +179,31 @@ void Separator::onMouseMove(QPoint pos)
                                                        : (positionToGoTo > position() ? Side2
                                                                                       : Side1); // Last case shouldn't happen though.
 
-    if (d->lazyResizeRubberBand)
+    if (d->lazyResizeRubberBand) {
         setLazyPosition(positionToGoTo);
-    else
+    } else {
+        if (positionToGoTo != position())
+            d->beginUndoOperation();
         d->parentContainer->requestSeparatorMove(this, positionToGoTo - position());
+    }
 }
 
 void Separator::onMouseReleased()
 {
     if (d->lazyResizeRubberBand) {
         d->lazyResizeRubberBand->hide();
+        if (isBeingDragged() && d->lazyPosition != position())
+            d->beginUndoOperation();
         d->parentContainer->requestSeparatorMove(this, d->lazyPosition - position());
     }
 
-    s_separatorBeingDragged = nullptr;
+    if (isBeingDragged()) {
+        s_separatorBeingDragged = nullptr;
+        if (d->undoOperationStarted) {
+            d->undoOperationStarted = false;
+            KDDockWidgets::LayoutUndoStack::self()->endOperation();
+        }
+    }
 }
 
 void Separator::setGeometry(QRect r)
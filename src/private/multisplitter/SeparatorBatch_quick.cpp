@@ -0,0 +1,318 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "SeparatorBatch_quick.h"
+#include "Rubberband_quick.h"
+#include "Widget_quick.h"
+#include "kddockwidgets/Qt5Qt6Compat_p.h"
+
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+
+using namespace Layouting;
+
+SeparatorBatchQuick::SeparatorBatchQuick(QQuickItem *host)
+    : QQuickItem(host)
+{
+    setFlag(ItemHasContents, true);
+    setAcceptedMouseButtons(Qt::LeftButton);
+    setAcceptHoverEvents(true);
+
+    // Separators don't overlap the frames, but stay on top anyway, contains() only accepts separator pixels
+    setZ(1);
+
+    auto fillHost = [this, host] {
+        setSize(host->size());
+    };
+    connect(host, &QQuickItem::widthChanged, this, fillHost);
+    connect(host, &QQuickItem::heightChanged, this, fillHost);
+    fillHost();
+}
+
+/** static */
+SeparatorBatchQuick *SeparatorBatchQuick::forHost(QQuickItem *host)
+{
+    if (auto batch = host->findChild<SeparatorBatchQuick *>(QString(), Qt::FindDirectChildrenOnly))
+        return batch;
+
+    return new SeparatorBatchQuick(host);
+}
+
+BatchedSeparatorQuick *SeparatorBatchQuick::separatorAt(QPointF pos) const
+{
+    const QPoint p = pos.toPoint();
+    for (BatchedSeparatorQuick *separator : m_separators) {
+        if (separator->m_visible && separator->m_geometry.contains(p))
+            return separator;
+    }
+
+    return nullptr;
+}
+
+const QVector<BatchedSeparatorQuick *> &SeparatorBatchQuick::separators() const
+{
+    return m_separators;
+}
+
+bool SeparatorBatchQuick::contains(const QPointF &point) const
+{
+    return m_pressedSeparator || separatorAt(point);
+}
+
+QSGNode *SeparatorBatchQuick::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    int numVisible = 0;
+    for (BatchedSeparatorQuick *separator : qAsConst(m_separators)) {
+        if (separator->m_visible && !separator->m_geometry.isEmpty())
+            numVisible++;
+    }
+
+    if (numVisible == 0) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    auto node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node) {
+        node = new QSGGeometryNode();
+        auto geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+
+        auto material = new QSGFlatColorMaterial();
+        material->setColor(QColor(0xef, 0xf0, 0xf1)); // Same as Separator.qml
+        node->setMaterial(material);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+
+    // Two triangles per separator, all in a single draw call
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(numVisible * 6);
+    QSGGeometry::Point2D *v = geometry->vertexDataAsPoint2D();
+    for (BatchedSeparatorQuick *separator : qAsConst(m_separators)) {
+        const QRect r = separator->m_geometry;
+        if (!separator->m_visible || r.isEmpty())
+            continue;
+
+        const float left = r.x();
+        const float top = r.y();
+        const float right = r.x() + r.width();
+        const float bottom = r.y() + r.height();
+
+        v[0].set(left, top);
+        v[1].set(right, top);
+        v[2].set(left, bottom);
+        v[3].set(right, top);
+        v[4].set(right, bottom);
+        v[5].set(left, bottom);
+        v += 6;
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+void SeparatorBatchQuick::updateCursor(BatchedSeparatorQuick *hovered)
+{
+    if (!hovered) {
+        unsetCursor();
+    } else {
+        setCursor(hovered->isVertical() ? Qt::SizeVerCursor : Qt::SizeHorCursor);
+    }
+}
+
+void SeparatorBatchQuick::hoverMoveEvent(QHoverEvent *ev)
+{
+    if (!m_pressedSeparator)
+        updateCursor(separatorAt(KDDockWidgets::Qt5Qt6Compat::eventPos(ev)));
+}
+
+void SeparatorBatchQuick::hoverLeaveEvent(QHoverEvent *)
+{
+    if (!m_pressedSeparator)
+        updateCursor(nullptr);
+}
+
+void SeparatorBatchQuick::mousePressEvent(QMouseEvent *ev)
+{
+    m_pressedSeparator = separatorAt(KDDockWidgets::Qt5Qt6Compat::eventPos(ev));
+    if (!m_pressedSeparator) {
+        ev->ignore();
+        return;
+    }
+
+    updateCursor(m_pressedSeparator);
+    m_pressedSeparator->onMousePress();
+}
+
+void SeparatorBatchQuick::mouseMoveEvent(QMouseEvent *ev)
+{
+    // We fill the host, so our coordinates are already the host's
+    if (m_pressedSeparator)
+        m_pressedSeparator->onMouseMove(KDDockWidgets::Qt5Qt6Compat::eventPos(ev));
+}
+
+void SeparatorBatchQuick::mouseReleaseEvent(QMouseEvent *)
+{
+    if (BatchedSeparatorQuick *separator = m_pressedSeparator) {
+        m_pressedSeparator = nullptr;
+        separator->onMouseReleased();
+    }
+}
+
+void SeparatorBatchQuick::mouseDoubleClickEvent(QMouseEvent *ev)
+{
+    if (BatchedSeparatorQuick *separator = separatorAt(KDDockWidgets::Qt5Qt6Compat::eventPos(ev)))
+        separator->onMouseDoubleClick();
+}
+
+void SeparatorBatchQuick::addSeparator(BatchedSeparatorQuick *separator)
+{
+    m_separators.push_back(separator);
+}
+
+void SeparatorBatchQuick::removeSeparator(BatchedSeparatorQuick *separator)
+{
+    m_separators.removeOne(separator);
+    if (m_pressedSeparator == separator)
+        m_pressedSeparator = nullptr;
+    update();
+}
+
+BatchedSeparatorQuick::BatchedSeparatorQuick(Layouting::Widget *parent)
+    : QObject(parent->asQObject())
+    , Separator(parent)
+    , Layouting::Widget(this)
+    , m_batch(SeparatorBatchQuick::forHost(qobject_cast<QQuickItem *>(parent->asQObject())))
+{
+    m_batch->addSeparator(this);
+}
+
+BatchedSeparatorQuick::~BatchedSeparatorQuick()
+{
+    if (m_batch)
+        m_batch->removeSeparator(this);
+}
+
+void BatchedSeparatorQuick::setLayoutItem(Item *)
+{
+}
+
+QSize BatchedSeparatorQuick::minSize() const
+{
+    return {};
+}
+
+QSize BatchedSeparatorQuick::maxSizeHint() const
+{
+    return {};
+}
+
+QRect BatchedSeparatorQuick::geometry() const
+{
+    return m_geometry;
+}
+
+void BatchedSeparatorQuick::setGeometry(QRect rect)
+{
+    if (rect == m_geometry)
+        return;
+
+    m_geometry = rect;
+    update();
+}
+
+void BatchedSeparatorQuick::setParent(Widget *)
+{
+    // The batch is per host, separators don't move between hosts
+    qWarning() << Q_FUNC_INFO << "Not supported";
+}
+
+QDebug &BatchedSeparatorQuick::dumpDebug(QDebug &d) const
+{
+    d << " Dump Start: Batched separator=" << m_geometry;
+    return d;
+}
+
+bool BatchedSeparatorQuick::isVisible() const
+{
+    return m_visible;
+}
+
+void BatchedSeparatorQuick::setVisible(bool is) const
+{
+    if (is == m_visible)
+        return;
+
+    m_visible = is;
+    if (m_batch)
+        m_batch->update();
+}
+
+void BatchedSeparatorQuick::move(int x, int y)
+{
+    setGeometry(QRect(QPoint(x, y), m_geometry.size()));
+}
+
+void BatchedSeparatorQuick::setSize(int width, int height)
+{
+    setGeometry(QRect(m_geometry.topLeft(), QSize(width, height)));
+}
+
+void BatchedSeparatorQuick::setWidth(int width)
+{
+    setSize(width, m_geometry.height());
+}
+
+void BatchedSeparatorQuick::setHeight(int height)
+{
+    setSize(m_geometry.width(), height);
+}
+
+std::unique_ptr<Widget> BatchedSeparatorQuick::parentWidget() const
+{
+    if (m_batch)
+        return std::unique_ptr<Widget>(new Widget_quick(m_batch->parentItem()));
+
+    return {};
+}
+
+void BatchedSeparatorQuick::show()
+{
+    setVisible(true);
+}
+
+void BatchedSeparatorQuick::hide()
+{
+    setVisible(false);
+}
+
+void BatchedSeparatorQuick::update()
+{
+    if (m_batch)
+        m_batch->update();
+}
+
+Layouting::Widget *BatchedSeparatorQuick::createRubberBand(Layouting::Widget *parent)
+{
+    if (!parent) {
+        qWarning() << Q_FUNC_INFO << "Parent is required";
+        return nullptr;
+    }
+
+    return new Layouting::Widget_quick(new Layouting::RubberBand(parent));
+}
+
+Layouting::Widget *BatchedSeparatorQuick::asWidget()
+{
+    return this;
+}
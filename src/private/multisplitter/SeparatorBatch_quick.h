@@ -0,0 +1,112 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2020-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#ifndef KD_MULTISPLITTER_SEPARATORBATCH_QUICK_H
+#define KD_MULTISPLITTER_SEPARATORBATCH_QUICK_H
+
+#include "kddockwidgets/docks_export.h"
+#include "Separator_p.h"
+#include "Widget.h"
+
+#include <QPointer>
+#include <QQuickItem>
+#include <QVector>
+
+namespace Layouting {
+
+class BatchedSeparatorQuick;
+
+/**
+ * @brief A single item per layout host which renders all its separators
+ *
+ * Instead of one QML item, with its own MouseArea, per separator, the separators of a layout are
+ * drawn as a single scene-graph geometry node. Hit-testing, hover and cursor are also done here.
+ */
+class DOCKS_EXPORT SeparatorBatchQuick : public QQuickItem
+{
+    Q_OBJECT
+public:
+    /// @brief Returns the batch for @p host, creating it if needed
+    static SeparatorBatchQuick *forHost(QQuickItem *host);
+
+    /// @brief Returns the visible separator at @p pos, in host coordinates
+    BatchedSeparatorQuick *separatorAt(QPointF pos) const;
+
+    const QVector<BatchedSeparatorQuick *> &separators() const;
+
+    bool contains(const QPointF &point) const override;
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void hoverMoveEvent(QHoverEvent *) override;
+    void hoverLeaveEvent(QHoverEvent *) override;
+    void mousePressEvent(QMouseEvent *) override;
+    void mouseMoveEvent(QMouseEvent *) override;
+    void mouseReleaseEvent(QMouseEvent *) override;
+    void mouseDoubleClickEvent(QMouseEvent *) override;
+
+private:
+    friend class BatchedSeparatorQuick;
+    explicit SeparatorBatchQuick(QQuickItem *host);
+    void addSeparator(BatchedSeparatorQuick *);
+    void removeSeparator(BatchedSeparatorQuick *);
+    void updateCursor(BatchedSeparatorQuick *hovered);
+
+    QVector<BatchedSeparatorQuick *> m_separators;
+    BatchedSeparatorQuick *m_pressedSeparator = nullptr;
+};
+
+/**
+ * @brief A separator without an item of its own. Rendered by SeparatorBatchQuick.
+ */
+class DOCKS_EXPORT BatchedSeparatorQuick
+    : public QObject,
+      public Layouting::Separator,
+      public Layouting::Widget
+{
+    Q_OBJECT
+public:
+    explicit BatchedSeparatorQuick(Layouting::Widget *parent);
+    ~BatchedSeparatorQuick() override;
+
+    // Layouting::Widget:
+    void setLayoutItem(Item *) override;
+    QSize minSize() const override;
+    QSize maxSizeHint() const override;
+    QRect geometry() const override;
+    void setGeometry(QRect) override;
+    void setParent(Widget *) override;
+    QDebug &dumpDebug(QDebug &) const override;
+    bool isVisible() const override;
+    void setVisible(bool) const override;
+    void move(int x, int y) override;
+    void setSize(int width, int height) override;
+    void setWidth(int width) override;
+    void setHeight(int height) override;
+    std::unique_ptr<Widget> parentWidget() const override;
+    void show() override;
+    void hide() override;
+    void update() override;
+
+protected:
+    Widget *createRubberBand(Widget *parent) override;
+    Widget *asWidget() override;
+
+private:
+    friend class SeparatorBatchQuick;
+    QPointer<SeparatorBatchQuick> m_batch;
+    QRect m_geometry;
+    mutable bool m_visible = false;
+};
+
+}
+
+#endif
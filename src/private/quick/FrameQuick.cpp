@@ -45,13 +45,12 @@ FrameQuick::FrameQuick(QWidgetAdapter *parent, FrameOptions options, int userTyp
         }
     });
 
-    QQmlComponent component(Config::self().qmlEngine(),
-                            Config::self().frameworkWidgetFactory()->frameFilename());
-
-    m_visualItem = static_cast<QQuickItem *>(component.create());
+    // The component is cached, so QML is only parsed for the first frame
+    m_visualItem = createItem(Config::self().qmlEngine(),
+                              Config::self().frameworkWidgetFactory()->frameFilename());
 
     if (!m_visualItem) {
-        qWarning() << Q_FUNC_INFO << "Failed to create item" << component.errorString();
+        qWarning() << Q_FUNC_INFO << "Failed to create item";
         return;
     }
 
@@ -29,10 +29,14 @@
 #include <QResizeEvent>
 #include <QMouseEvent>
 #include <QQmlComponent>
+#include <QQmlIncubator>
 #include <QQuickItem>
 #include <QQmlEngine>
 #include <QQuickView>
 #include <QScopedValueRollback>
+#include <QPointer>
+#include <QDir>
+#include <QTimer>
 
 #include <qpa/qplatformwindow.h>
 #include <QtGui/private/qhighdpiscaling_p.h>
@@ -106,6 +110,85 @@ MouseEventRedirector::~MouseEventRedirector()
     s_mouseEventRedirectors.remove(m_eventSource);
 }
 
+/**
+ * @brief Single application event filter which routes QWindow events to the QWidgetAdapters in that window.
+ * Instead of each QWidgetAdapter filtering every application event.
+ */
+class WindowEventDispatcher : public QObject /// clazy:exclude=missing-qobject-macro
+{
+public:
+    static WindowEventDispatcher *self()
+    {
+        if (!s_dispatcher)
+            s_dispatcher = new WindowEventDispatcher();
+        return s_dispatcher;
+    }
+
+    /// @brief Returns the dispatcher, without creating it. It's gone after QCoreApplication is destroyed.
+    static WindowEventDispatcher *existingInstance()
+    {
+        return s_dispatcher;
+    }
+
+    void setWindowForAdapter(QWidgetAdapter *adapter, QWindow *window)
+    {
+        if (QWindow *oldWindow = m_windowForAdapter.take(adapter)) {
+            auto it = m_adaptersForWindow.find(oldWindow);
+            it->removeOne(adapter);
+            if (it->isEmpty())
+                m_adaptersForWindow.erase(it);
+        }
+
+        if (window) {
+            m_windowForAdapter.insert(adapter, window);
+            m_adaptersForWindow[window].append(adapter);
+        }
+    }
+
+    bool eventFilter(QObject *watched, QEvent *ev) override
+    {
+        switch (ev->type()) {
+        case QEvent::MouseMove:
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseButtonRelease:
+        case QEvent::Resize:
+        case QEvent::Move:
+            break;
+        default:
+            return false;
+        }
+
+        auto window = qobject_cast<QWindow *>(watched);
+        if (!window)
+            return false;
+
+        // Copied, as adapters might be created, reparented or destroyed while handling the event
+        const QVector<QWidgetAdapter *> adapters = m_adaptersForWindow.value(window);
+        for (QWidgetAdapter *adapter : adapters) {
+            if (m_windowForAdapter.value(adapter) != window)
+                continue;
+
+            if (static_cast<QObject *>(adapter)->eventFilter(window, ev))
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    WindowEventDispatcher()
+        : QObject(qApp)
+    {
+        qApp->installEventFilter(this);
+    }
+
+    QHash<QWindow *, QVector<QWidgetAdapter *>> m_adaptersForWindow;
+    QHash<QWidgetAdapter *, QWindow *> m_windowForAdapter;
+    static QPointer<WindowEventDispatcher> s_dispatcher;
+};
+
+QPointer<WindowEventDispatcher> WindowEventDispatcher::s_dispatcher;
+
 }
 
 static bool flagsAreTopLevelFlags(Qt::WindowFlags flags)
@@ -142,13 +225,19 @@ QWidgetAdapter::QWidgetAdapter(QQuickItem *parent, Qt::WindowFlags flags)
         }
     });
 
-    qApp->installEventFilter(this);
+    connect(this, &QQuickItem::windowChanged, this, [this](QQuickWindow *window) {
+        if (auto dispatcher = WindowEventDispatcher::existingInstance())
+            dispatcher->setWindowForAdapter(this, window);
+    });
+    WindowEventDispatcher::self()->setWindowForAdapter(this, QQuickItem::window());
 
     setSize(QSize(800, 800));
 }
 
 QWidgetAdapter::~QWidgetAdapter()
 {
+    if (auto dispatcher = WindowEventDispatcher::existingInstance())
+        dispatcher->setWindowForAdapter(this, nullptr);
 }
 
 void QWidgetAdapter::raiseAndActivate()
@@ -683,19 +772,133 @@ Qt::WindowFlags QWidgetAdapter::windowFlags() const
     return m_windowFlags;
 }
 
+namespace {
+// Parsed components, per engine. Each component is a child of its engine.
+QHash<QQmlEngine *, QHash<QUrl, QQmlComponent *>> s_componentCache;
+int s_componentCacheHits = 0;
+int s_componentCacheMisses = 0;
+
+// Converts a filename, as accepted by QQmlComponent's ctor, into the url used as cache key
+QUrl urlForFilename(QQmlEngine *engine, const QString &filename)
+{
+    if (filename.startsWith(QLatin1Char(':')))
+        return QUrl(QLatin1String("qrc") + filename);
+
+    const QUrl url = QDir::isAbsolutePath(filename) ? QUrl::fromLocalFile(filename) : QUrl(filename);
+    return engine->baseUrl().resolved(url);
+}
+
+class ItemIncubator : public QQmlIncubator
+{
+public:
+    ItemIncubator(QObject *receiver, const std::function<void(QQuickItem *)> &onCreated)
+        : QQmlIncubator(QQmlIncubator::Asynchronous)
+        , m_receiver(receiver)
+        , m_onCreated(onCreated)
+    {
+    }
+
+protected:
+    void statusChanged(Status status) override
+    {
+        if (status == QQmlIncubator::Ready) {
+            QObject *obj = object();
+            auto item = qobject_cast<QQuickItem *>(obj);
+            if (m_receiver && item) {
+                m_onCreated(item);
+            } else {
+                delete obj;
+            }
+        } else if (status == QQmlIncubator::Error) {
+            qWarning() << Q_FUNC_INFO << errors();
+        } else {
+            return;
+        }
+
+        // Can't delete the incubator while QML is still calling into it
+        QTimer::singleShot(0, [this] { delete this; });
+    }
+
+private:
+    const QPointer<QObject> m_receiver;
+    const std::function<void(QQuickItem *)> m_onCreated;
+};
+}
+
+/** static */
+QQmlComponent *QWidgetAdapter::cachedComponent(QQmlEngine *engine, const QUrl &url)
+{
+    auto it = s_componentCache.find(engine);
+    if (it == s_componentCache.end()) {
+        it = s_componentCache.insert(engine, {});
+        QObject::connect(engine, &QObject::destroyed, [engine] {
+            s_componentCache.remove(engine);
+        });
+    }
+
+    QQmlComponent *&component = (*it)[url];
+    if (component && component->isError()) {
+        // Don't cache failures. Deleted later, as the previous caller might still be reporting the error.
+        component->deleteLater();
+        component = nullptr;
+    }
+
+    if (component) {
+        s_componentCacheHits++;
+    } else {
+        s_componentCacheMisses++;
+        component = new QQmlComponent(engine, url, engine);
+    }
+
+    return component;
+}
+
+/** static */
+int QWidgetAdapter::dbg_componentCacheHits()
+{
+    return s_componentCacheHits;
+}
+
+/** static */
+int QWidgetAdapter::dbg_componentCacheMisses()
+{
+    return s_componentCacheMisses;
+}
+
 /** static */
 QQuickItem *QWidgetAdapter::createItem(QQmlEngine *engine, const QString &filename)
 {
-    QQmlComponent component(engine, filename);
-    QObject *obj = component.create();
+    return createItem(engine, urlForFilename(engine, filename));
+}
+
+/** static */
+QQuickItem *QWidgetAdapter::createItem(QQmlEngine *engine, const QUrl &url)
+{
+    QQmlComponent *component = cachedComponent(engine, url);
+    QObject *obj = component->create();
     if (!obj) {
-        qWarning() << Q_FUNC_INFO << component.errorString();
+        qWarning() << Q_FUNC_INFO << component->errorString();
         return nullptr;
     }
 
     return qobject_cast<QQuickItem *>(obj);
 }
 
+/** static */
+void QWidgetAdapter::createItemAsync(QQmlEngine *engine, const QString &filename, QObject *receiver,
+                                     const std::function<void(QQuickItem *)> &onCreated)
+{
+    QQmlComponent *component = cachedComponent(engine, urlForFilename(engine, filename));
+    if (!engine->incubationController() || !component->isReady()) {
+        // Without a controller nobody would drive the incubation. Errors are reported by createItem().
+        if (QQuickItem *item = createItem(engine, filename))
+            onCreated(item);
+        return;
+    }
+
+    component->create(*new ItemIncubator(receiver, onCreated));
+}
+
 void QWidgetAdapter::makeItemFillParent(QQuickItem *item)
 {
     // This is equivalent to "anchors.fill: parent
@@ -30,9 +30,12 @@
 #include <QQuickWindow>
 #include <QScreen>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 class QWindow;
 class QQmlEngine;
+class QQmlComponent;
 class QQuickView;
 QT_END_NAMESPACE
 
@@ -234,6 +237,23 @@ public:
     bool isWrapper() const;
 
     static QQuickItem *createItem(QQmlEngine *, const QString &filename);
+    static QQuickItem *createItem(QQmlEngine *, const QUrl &url);
+
+    /// @brief Creates the item asynchronously, with a QQmlIncubator, so the render loop isn't blocked
+    /// @p onCreated is called once the item is ready, unless @p receiver was destroyed meanwhile.
+    /// Falls back to synchronous creation if the engine doesn't have an incubation controller.
+    static void createItemAsync(QQmlEngine *, const QString &filename, QObject *receiver,
+                                const std::function<void(QQuickItem *)> &onCreated);
+
+    /// @brief Returns the component for @p url, which is only parsed once per engine
+    /// Components which failed to load are loaded again on the next call.
+    static QQmlComponent *cachedComponent(QQmlEngine *, const QUrl &url);
+
+    ///@brief For tests-only. Returns how many cachedComponent() calls were served by the cache.
+    static int dbg_componentCacheHits();
+
+    ///@brief For tests-only. Returns how many cachedComponent() calls had to load the component.
+    static int dbg_componentCacheMisses();
     static void makeItemFillParent(QQuickItem *item);
 Q_SIGNALS:
     void geometryUpdated(); // similar to QLayout stuff, when size constraints change
@@ -16,9 +16,9 @@ Image {
     id: root
 
     property int indicatorType: KDDockWidgets.DropLocation_None
-    readonly property bool isHovered: _window.classicIndicators.currentDropLocation === indicatorType
+    readonly property bool isHovered: _window.classicIndicators.currentDropLocation === root.indicatorType
 
-    source: "qrc:/img/classic_indicators/" + _window.iconName(indicatorType, isHovered) + ".png";
+    source: "qrc:/img/classic_indicators/" + _window.iconName(root.indicatorType, root.isHovered) + ".png";
     width: 64
     height: 64
 }
@@ -19,14 +19,14 @@ Rectangle {
     id: root
 
     property QtObject frameCpp
-    readonly property QtObject titleBarCpp: frameCpp ? frameCpp.titleBar : null
-    readonly property int nonContentsHeight: (titleBar.item ? titleBar.item.heightWhenVisible : 0) + tabbar.implicitHeight + (2 * contentsMargin) + titleBarContentsMargin
-    property int contentsMargin: isMDI ? 2 : 1
+    readonly property QtObject titleBarCpp: root.frameCpp ? root.frameCpp.titleBar : null
+    readonly property int nonContentsHeight: (titleBar.item ? titleBar.item.heightWhenVisible : 0) + tabbar.implicitHeight + (2 * root.contentsMargin) + root.titleBarContentsMargin
+    property int contentsMargin: root.isMDI ? 2 : 1
     property int titleBarContentsMargin: 1
     property bool hasCustomMouseEventRedirector: false
     property int mouseResizeMargin: 8
-    readonly property bool isMDI: frameCpp && frameCpp.isMDI
-    readonly property bool resizeAllowed: root.isMDI && !_kddwDragController.isDragging && _kddwDockRegistry && (!_kddwDockRegistry.frameInMDIResize || _kddwDockRegistry.frameInMDIResize === frameCpp)
+    readonly property bool isMDI: root.frameCpp && root.frameCpp.isMDI
+    readonly property bool resizeAllowed: root.isMDI && !_kddwDragController.isDragging && _kddwDockRegistry && (!_kddwDockRegistry.frameInMDIResize || _kddwDockRegistry.frameInMDIResize === root.frameCpp)
     property alias tabBarHeight: tabbar.height
 
     anchors.fill: parent
@@ -39,14 +39,14 @@ Rectangle {
     }
 
     onFrameCppChanged: {
-        if (frameCpp) {
-            frameCpp.setStackLayout(stackLayout);
+        if (root.frameCpp) {
+            root.frameCpp.setStackLayout(stackLayout);
         }
     }
 
     onNonContentsHeightChanged: {
-        if (frameCpp)
-            frameCpp.geometryUpdated();
+        if (root.frameCpp)
+            root.frameCpp.geometryUpdated();
     }
 
     ResizeHandlerHelper {
@@ -56,7 +56,7 @@ Rectangle {
             bottom: parent ? parent.bottom : undefined
         }
 
-        width: resizeMargin
+        width: root.mouseResizeMargin
         z: 100
         frameCpp: root.frameCpp
         resizeAllowed: root.resizeAllowed
@@ -71,7 +71,7 @@ Rectangle {
             bottom: parent ? parent.bottom : undefined
         }
 
-        width: resizeMargin
+        width: root.mouseResizeMargin
         z: 100
         frameCpp: root.frameCpp
         resizeAllowed: root.resizeAllowed
@@ -86,7 +86,7 @@ Rectangle {
             left: parent ? parent.left : undefined
         }
 
-        height: resizeMargin
+        height: root.mouseResizeMargin
         z: 100
         frameCpp: root.frameCpp
         resizeAllowed: root.resizeAllowed
@@ -101,7 +101,7 @@ Rectangle {
             bottom: parent ?  parent.bottom : undefined
         }
 
-        height: resizeMargin
+        height: root.mouseResizeMargin
         z: 100
         frameCpp: root.frameCpp
         resizeAllowed: root.resizeAllowed
@@ -115,8 +115,8 @@ Rectangle {
             bottom: parent ? parent.bottom : undefined
         }
 
-        height: width
-        width: resizeMargin
+        height: root.mouseResizeMargin
+        width: root.mouseResizeMargin
         z: 101
         frameCpp: root.frameCpp
         resizeAllowed: root.resizeAllowed
@@ -130,8 +130,8 @@ Rectangle {
             top:  parent ? parent.top : undefined
         }
 
-        height: width
-        width: resizeMargin
+        height: root.mouseResizeMargin
+        width: root.mouseResizeMargin
         z: 101
         frameCpp: root.frameCpp
         resizeAllowed: root.resizeAllowed
@@ -145,8 +145,8 @@ Rectangle {
             top: parent ? parent.top : undefined
         }
 
-        height: width
-        width: resizeMargin
+        height: root.mouseResizeMargin
+        width: root.mouseResizeMargin
         z: 101
         frameCpp: root.frameCpp
         resizeAllowed: root.resizeAllowed
@@ -160,8 +160,8 @@ Rectangle {
             bottom: parent ? parent.bottom : undefined
         }
 
-        height: width
-        width: resizeMargin
+        height: root.mouseResizeMargin
+        width: root.mouseResizeMargin
         z: 101
         frameCpp: root.frameCpp
         resizeAllowed: root.resizeAllowed
@@ -172,7 +172,7 @@ Rectangle {
     Loader {
         id: titleBar
         readonly property QtObject titleBarCpp: root.titleBarCpp
-        source: frameCpp ? _kddw_widgetFactory.titleBarFilename()
+        source: root.frameCpp ? _kddw_widgetFactory.titleBarFilename()
                          : ""
 
         anchors {
@@ -186,9 +186,9 @@ Rectangle {
     }
 
     Connections {
-        target: frameCpp
+        target: root.frameCpp
         function onCurrentIndexChanged() {
-            tabbar.currentIndex = frameCpp.currentIndex;
+            tabbar.currentIndex = root.frameCpp.currentIndex;
         }
     }
 
@@ -207,8 +207,8 @@ Rectangle {
         readonly property QtObject tabBarCpp: root.frameCpp ? root.frameCpp.tabWidget.tabBar
                                                             : null
 
-        visible: count > 1
-        height: visible ? implicitHeight : 0
+        visible: tabbar.count > 1
+        height: tabbar.visible ? tabbar.implicitHeight : 0
 
         anchors {
             left: parent ? parent.left : undefined
@@ -224,16 +224,16 @@ Rectangle {
 
         onCurrentIndexChanged: {
             if (root && root.frameCpp)
-                root.frameCpp.tabWidget.setCurrentDockWidget(currentIndex);
+                root.frameCpp.tabWidget.setCurrentDockWidget(tabbar.currentIndex);
         }
 
         onTabBarCppChanged: {
-            if (tabBarCpp) {
+            if (tabbar.tabBarCpp) {
                 if (!root.hasCustomMouseEventRedirector)
-                    tabBarCpp.redirectMouseEvents(dragMouseArea)
+                    tabbar.tabBarCpp.redirectMouseEvents(dragMouseArea)
 
                 // Setting just so the unit-tests can access the buttons
-                tabBarCpp.tabBarQmlItem = this;
+                tabbar.tabBarCpp.tabBarQmlItem = tabbar;
             }
         }
 
@@ -44,7 +44,8 @@ DockWidget::DockWidget(const QString &name, Options options, LayoutSaverOptions
     , d(new Private(this))
 {
     connect(this, &DockWidgetBase::widgetChanged, this, [this](QWidget *w) {
-        d->layout->addWidget(w);
+        if (w) // nullptr when the guest is hibernated
+            d->layout->addWidget(w);
     });
 }
 
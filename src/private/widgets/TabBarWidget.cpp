@@ -19,6 +19,7 @@
 
 #include "TabBarWidget_p.h"
 #include "Config.h"
+#include "LayoutUndoStack.h"
 
 #include <QMouseEvent>
 #include <QApplication>
@@ -68,6 +69,10 @@ TabBarWidget::TabBarWidget(TabWidget *parent)
 {
     setMovable(Config::self().flags() & Config::Flag_AllowReorderTabs);
     setStyle(proxyStyle());
+
+    connect(this, &QTabBar::tabMoved, this, [this] {
+        m_tabMovedSincePress = true;
+    });
 }
 
 int TabBarWidget::tabAt(QPoint localPos) const
@@ -84,6 +89,10 @@ DockWidgetBase *TabBarWidget::currentDockWidget() const
 
 void TabBarWidget::mousePressEvent(QMouseEvent *e)
 {
+    m_tabMovedSincePress = false;
+    m_undoOperationStarted = false;
+    m_pressPos = e->pos();
+
     onMousePress(e->pos());
     QTabBar::mousePressEvent(e);
 }
@@ -91,11 +100,33 @@ void TabBarWidget::mousePressEvent(QMouseEvent *e)
 void TabBarWidget::mouseMoveEvent(QMouseEvent *e)
 {
     if (count() > 1) {
+        // A re-order might start now, QTabBar only moves tabs once past the drag distance
+        if (!m_undoOperationStarted && isMovable() && (e->buttons() & Qt::LeftButton)
+            && (e->pos() - m_pressPos).manhattanLength() > QApplication::startDragDistance()) {
+            m_undoOperationStarted = true;
+            LayoutUndoStack::self()->beginOperation();
+        }
+
         // Only allow to re-order tabs if we have more than 1 tab, otherwise it's just weird.
         QTabBar::mouseMoveEvent(e);
     }
 }
 
+void TabBarWidget::mouseReleaseEvent(QMouseEvent *e)
+{
+    QTabBar::mouseReleaseEvent(e);
+
+    if (m_undoOperationStarted) {
+        m_undoOperationStarted = false;
+        if (m_tabMovedSincePress)
+            LayoutUndoStack::self()->endOperation();
+        else // Dragged, but dropped back at the same index
+            LayoutUndoStack::self()->cancelOperation();
+    }
+
+    m_tabMovedSincePress = false;
+}
+
 void TabBarWidget::mouseDoubleClickEvent(QMouseEvent *e)
 {
     TabBar::onMouseDoubleClick(e->pos());
@@ -58,6 +58,7 @@ protected:
     bool dragCanStart(QPoint pressPos, QPoint pos) const override;
     void mousePressEvent(QMouseEvent *) override;
     void mouseMoveEvent(QMouseEvent *e) override;
+    void mouseReleaseEvent(QMouseEvent *e) override;
     void mouseDoubleClickEvent(QMouseEvent *e) override;
     bool event(QEvent *) override;
     void tabInserted(int index) override;
@@ -65,6 +66,9 @@ protected:
 
 private:
     TabWidget *const m_tabWidget;
+    bool m_tabMovedSincePress = false;
+    bool m_undoOperationStarted = false;
+    QPoint m_pressPos;
 };
 }
 
@@ -0,0 +1,145 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/// @file
+/// @brief Counts the heap allocations done per separator move and per drop area hover.
+/// Replaces the global operator new, so library allocations are only counted where they go through it,
+/// like on Linux. Pass the number of dock widgets as argument.
+
+#include "DockWidget.h"
+#include "MainWindow.h"
+#include "private/DropAreaWithCentralFrame_p.h"
+#include "private/FloatingWindow_p.h"
+#include "private/WindowBeingDragged_p.h"
+#include "private/multisplitter/Item_p.h"
+#include "private/multisplitter/Separator_p.h"
+
+#include <QApplication>
+#include <QDebug>
+#include <QLabel>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<quint64> s_numAllocations(0);
+
+void *operator new(std::size_t size)
+{
+    s_numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace KDDockWidgets;
+
+static const int s_numIterations = 1000;
+
+static void report(const char *what, quint64 numAllocations)
+{
+    qInfo().noquote() << QStringLiteral("%1: %2 allocations per call")
+                             .arg(QLatin1String(what))
+                             .arg(double(numAllocations) / s_numIterations, 0, 'f', 1);
+}
+
+/// @brief Moves the separator back and forth, like Separator::onMouseMove() does
+static quint64 measureSeparatorMove(Layouting::Separator *separator)
+{
+    Layouting::ItemBoxContainer *container = separator->parentContainer();
+    const quint64 before = s_numAllocations;
+    for (int i = 0; i < s_numIterations; ++i) {
+        const int delta = i % 2 ? -10 : 10;
+        const int positionToGoTo = separator->position() + delta;
+        const int minPos = container->minPosForSeparator_global(separator);
+        const int maxPos = container->maxPosForSeparator_global(separator);
+        if (positionToGoTo >= minPos && positionToGoTo <= maxPos)
+            container->requestSeparatorMove(separator, delta);
+    }
+
+    return s_numAllocations - before;
+}
+
+static quint64 measureHover(DropArea *dropArea, FloatingWindow *floatingWindow)
+{
+    WindowBeingDragged windowBeingDragged(floatingWindow, floatingWindow);
+    const QRect globalRect(dropArea->mapToGlobal(QPoint(0, 0)), dropArea->size());
+
+    const quint64 before = s_numAllocations;
+    for (int i = 0; i < s_numIterations; ++i) {
+        const QPoint globalPos(globalRect.left() + (i * 7) % globalRect.width(),
+                               globalRect.top() + (i * 13) % globalRect.height());
+        dropArea->hover(&windowBeingDragged, globalPos);
+    }
+    const quint64 numAllocations = s_numAllocations - before;
+
+    dropArea->removeHover();
+    return numAllocations;
+}
+
+int main(int argc, char *argv[])
+{
+    bool qpaPassed = false;
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "-platform") == 0) {
+            qpaPassed = true;
+            break;
+        }
+    }
+
+    if (!qpaPassed) {
+        // Use offscreen by default as it's less annoying, doesn't create visible windows
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    const int numDocks = argc > 1 ? QString::fromLocal8Bit(argv[1]).toInt() : 20;
+
+    MainWindow mainWindow(QStringLiteral("bench"));
+    mainWindow.resize(1600, 1200);
+    mainWindow.show();
+
+    DockWidgetBase *previous = nullptr;
+    for (int i = 0; i < numDocks; ++i) {
+        auto dock = new DockWidget(QStringLiteral("dock%1").arg(i));
+        dock->setWidget(new QLabel(dock->uniqueName()));
+        mainWindow.addDockWidget(dock, i % 2 ? Location_OnRight : Location_OnBottom, previous);
+        previous = dock;
+    }
+
+    auto floatingDock = new DockWidget(QStringLiteral("floating"));
+    floatingDock->setWidget(new QLabel(floatingDock->uniqueName()));
+    floatingDock->show();
+    auto floatingWindow = qobject_cast<FloatingWindow *>(floatingDock->window());
+
+    app.processEvents();
+
+    const QVector<Layouting::Separator *> separators = mainWindow.multiSplitter()->separators();
+    if (separators.isEmpty() || !floatingWindow) {
+        qWarning() << "Failed to create the layout";
+        return 1;
+    }
+
+    report("Separator move", measureSeparatorMove(separators.at(separators.size() / 2)));
+    report("Drop area hover", measureHover(mainWindow.dropArea(), floatingWindow));
+
+    return 0;
+}
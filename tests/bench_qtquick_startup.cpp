@@ -0,0 +1,80 @@
+/*
+  This file is part of KDDockWidgets.
+
+  SPDX-FileCopyrightText: 2019-2023 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+  Author: Sérgio Martins <sergio.martins@kdab.com>
+
+  SPDX-License-Identifier: GPL-2.0-only OR GPL-3.0-only
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+/// @file
+/// @brief Measures the time from startup until the first frame of a QtQuick main window with docks is rendered.
+/// Run it from a build with KDDockWidgets_QML_AOT=ON and from one with it OFF to compare.
+/// Each run is a new process, so nothing is cached in memory. Pass the number of dock widgets as argument.
+
+#include "Config.h"
+#include "DockWidgetQuick.h"
+#include "MainWindowBase.h"
+#include "private/DockRegistry_p.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QQmlApplicationEngine>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QTimer>
+
+using namespace KDDockWidgets;
+
+int main(int argc, char *argv[])
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QGuiApplication app(argc, argv);
+    const int numDocks = argc > 1 ? QString::fromLocal8Bit(argv[1]).toInt() : 20;
+
+    QQmlApplicationEngine engine;
+    Config::self().setQmlEngine(&engine);
+    engine.loadData(QByteArrayLiteral("import QtQuick 2.6\n"
+                                      "import QtQuick.Controls 2.12\n"
+                                      "import com.kdab.dockwidgets 1.0 as KDDW\n"
+                                      "ApplicationWindow {\n"
+                                      "    visible: true; width: 1000; height: 800\n"
+                                      "    KDDW.MainWindowLayout { anchors.fill: parent; uniqueName: \"bench\" }\n"
+                                      "}\n"));
+
+    const auto mainWindows = DockRegistry::self()->mainwindows();
+    if (mainWindows.isEmpty() || engine.rootObjects().isEmpty()) {
+        qWarning() << "Failed to create main window";
+        return 1;
+    }
+
+    MainWindowBase *mainWindow = mainWindows.constFirst();
+    DockWidgetBase *previous = nullptr;
+    for (int i = 0; i < numDocks; ++i) {
+        auto dock = new DockWidgetQuick(QStringLiteral("dock%1").arg(i));
+        dock->setWidget(new QQuickItem());
+        if (previous && i % 2)
+            previous->addDockWidgetAsTab(dock);
+        else
+            mainWindow->addDockWidget(dock, i % 4 ? Location_OnRight : Location_OnBottom);
+        previous = dock;
+    }
+
+    QQuickWindow *window = qobject_cast<QQuickWindow *>(engine.rootObjects().constFirst());
+    QObject::connect(window, &QQuickWindow::frameSwapped, &app, [&timer] {
+#ifdef KDDW_QML_AOT
+        const char *mode = "ahead-of-time compiled QML";
+#else
+        const char *mode = "QML compiled at runtime";
+#endif
+        qInfo().noquote() << QStringLiteral("Time to first frame: %1 ms (%2)").arg(timer.elapsed()).arg(QLatin1String(mode));
+        QTimer::singleShot(0, qApp, &QCoreApplication::quit);
+    });
+
+    return app.exec();
+}
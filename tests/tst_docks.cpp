@@ -16,17 +16,23 @@
 #include "Config.h"
 #include "DockWidgetBase.h"
 #include "DockWidgetBase_p.h"
+#include "DragController_p.h"
 #include "DropAreaWithCentralFrame_p.h"
 #include "Frame_p.h"
+#include "FrameworkWidgetFactory.h"
+#include "InputRecorder_p.h"
 #include "KDDockWidgets.h"
 #include "LayoutSaver.h"
 #include "LayoutSaver_p.h"
+#include "LayoutSnapshot.h"
+#include "LayoutUndoStack.h"
 #include "MDILayoutWidget_p.h"
 #include "MainWindowMDI.h"
 #include "Position_p.h"
 #include "SideBar_p.h"
 #include "TabWidget_p.h"
 #include "TitleBar_p.h"
+#include "WidgetResizeHandler_p.h"
 #include "WindowBeingDragged_p.h"
 #include "MDIArea.h"
 #include "multisplitter/Separator_p.h"
@@ -34,6 +40,16 @@
 #include "private/MultiSplitter_p.h"
 
 #include <QAction>
+#include <QThread>
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+#include "private/indicators/SegmentedIndicators_p.h"
+
+#include <QRubberBand>
+#else
+#include <QQmlComponent>
+#include "private/multisplitter/SeparatorBatch_quick.h"
+#endif
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -6236,6 +6252,39 @@ void TestDocks::tst_fixedSizePolicy()
     delete dock1->window();
 }
 
+void TestDocks::tst_coalesceLayoutRequests()
+{
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_CoalesceLayoutRequests);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto w = new MyWidget2(QSize(100, 100));
+    auto dock1 = createDockWidget("dock1", w);
+    m->addDockWidget(dock1, Location_OnLeft);
+
+    Frame *frame = dock1->dptr()->frame();
+    ItemBoxContainer *root = m->multiSplitter()->rootItem();
+    Item *item = m->multiSplitter()->itemForFrame(frame);
+    const int numCoalesced = root->numCoalescedLayoutRequests();
+
+    // A guest rebuilding its contents, requesting many layouts in the same event loop turn
+    w->setMinimumSize(QSize(300, 300));
+    for (int i = 0; i < 10; ++i)
+        Q_EMIT frame->layoutInvalidated();
+
+    // Only the first one is queued, and it's only applied in the next frame
+    QVERIFY(root->numCoalescedLayoutRequests() >= numCoalesced + 9);
+    QTRY_VERIFY(item->minSize().width() >= 300);
+    QVERIFY(root->checkSanity());
+
+    // Can also be applied immediately
+    w->setMinimumSize(QSize(400, 400));
+    Q_EMIT frame->layoutInvalidated();
+    root->applyPendingLayoutRequests();
+    QVERIFY(item->minSize().width() >= 400);
+    QVERIFY(root->checkSanity());
+}
+
 #endif
 
 void TestDocks::tst_floatingAction()
@@ -8014,3 +8063,981 @@ void TestDocks::tst_restoreFlagsFromVersion16()
     QVERIFY(floatingWindow);
     QCOMPARE(floatingWindow->floatingWindowFlags(), FloatingWindowFlag::HideTitleBarWhenTabsVisible);
 }
+
+void TestDocks::tst_coalesceDragMouseMoves()
+{
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_CoalesceDragMouseMoves);
+    KDDockWidgets::Config::self().setDragStatisticsEnabled(true);
+
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new QPushButton("1"));
+    auto fw = dock1->floatingWindow();
+    fw->move(m->pos() + QPoint(500, 500));
+
+    auto draggable = draggableFor(fw);
+    const QPoint center = m->mapToGlobal(m->rect().center());
+    drag(draggable, KDDockWidgets::mapToGlobal(draggable, QPoint(10, 10)), center, ButtonAction_Press);
+
+    // A burst of moves within the same event loop iteration, like a high polling-rate mouse produces
+    const int numQueuedMoves = 20;
+    for (int i = 1; i <= numQueuedMoves; ++i) {
+        const QPoint pos = center + QPoint(i, 0);
+        QCursor::setPos(pos);
+        QMouseEvent ev(QEvent::MouseMove, draggable->mapFromGlobal(pos), draggable->window()->mapFromGlobal(pos), pos,
+                       Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+        qApp->sendEvent(draggable, &ev);
+    }
+
+    // Hovering and dropping still work
+    const QPoint dropPoint = m->dropArea()->dropIndicatorOverlay()->posForIndicator(DropLocation_Right);
+    moveMouseTo(dropPoint, draggable);
+    releaseOn(dropPoint, draggable);
+    QVERIFY(dock1->isInMainWindow());
+    QVERIFY(DragController::instance()->isIdle());
+
+    // At most the first and the last moves of the burst were processed
+    const DragStatistics stats = DragController::instance()->lastDragStatistics();
+    const int numProcessedMoves = stats.phase(DragPhase::Dragging).count;
+    QVERIFY(numProcessedMoves <= stats.numMouseMoves - (numQueuedMoves - 2));
+    QVERIFY(stats.phase(DragPhase::DropAreaHover).count <= numProcessedMoves);
+}
+
+void TestDocks::tst_dragStatistics()
+{
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setDragStatisticsEnabled(true);
+
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new QPushButton("1"));
+    auto fw = dock1->floatingWindow();
+    fw->move(m->pos() + QPoint(500, 500));
+
+    dragFloatingWindowTo(fw, m->dropArea(), DropLocation_Right);
+    QVERIFY(dock1->isInMainWindow());
+
+    const DragStatistics stats = DragController::instance()->lastDragStatistics();
+    QVERIFY(stats.dropped);
+    QVERIFY(stats.numMouseMoves > 0);
+    QVERIFY(stats.phase(DragPhase::Dragging).count > 0);
+    QVERIFY(stats.phase(DragPhase::DropAreaHover).count > 0);
+    QCOMPARE(stats.phase(DragPhase::Drop).count, 1);
+    QVERIFY(stats.phase(DragPhase::Dragging).p50 <= stats.phase(DragPhase::Dragging).p95);
+    QVERIFY(stats.phase(DragPhase::Dragging).p95 <= stats.phase(DragPhase::Dragging).max);
+}
+
+void TestDocks::tst_recordAndReplayInput()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new QPushButton("1"));
+    QWindow *window = dock1->floatingWindow()->windowHandle();
+    QVERIFY(window);
+    QCOMPARE(InputRecorder::windowId(window), QStringLiteral("floatingwindow:dock1"));
+    QCOMPARE(InputRecorder::windowForId(QStringLiteral("floatingwindow:dock1")), window);
+
+    InputRecorder recorder;
+    recorder.startRecording();
+
+    const QPoint globalPos = window->mapToGlobal(QPoint(5, 5));
+    QMouseEvent press(QEvent::MouseButtonPress, QPoint(5, 5), QPoint(5, 5), globalPos,
+                      Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+    QMouseEvent release(QEvent::MouseButtonRelease, QPoint(5, 5), QPoint(5, 5), globalPos,
+                        Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+    qApp->sendEvent(window, &press);
+    qApp->sendEvent(window, &release);
+
+    QCOMPARE(recorder.events().size(), 2);
+    const QByteArray recording = recorder.stopRecording();
+    QVERIFY(!recorder.isRecording());
+
+    InputReplayer replayer;
+    QVERIFY(replayer.load(recording));
+    QCOMPARE(replayer.events().size(), 2);
+    QCOMPARE(replayer.events().at(0).type, QEvent::MouseButtonPress);
+    QCOMPARE(replayer.events().at(0).globalPos, globalPos);
+    QCOMPARE(replayer.events().at(1).buttons, Qt::MouseButtons(Qt::NoButton));
+
+    QVERIFY(replayer.restoreInitialLayout());
+    const InputReplayer::Result result = replayer.replay();
+    QCOMPARE(result.numEvents, 2);
+    QCOMPARE(result.numSkippedEvents, 0);
+    QCOMPARE(result.pressTimings.count, 1);
+    QCOMPARE(result.releaseTimings.count, 1);
+}
+
+void TestDocks::tst_lightweightDragProxy()
+{
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_LightweightDragProxy);
+
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new QPushButton("1"));
+    auto fw = dock1->floatingWindow();
+    fw->move(m->pos() + QPoint(500, 500));
+    const QPoint originalPos = fw->windowHandle()->position();
+
+    // While dragging, only the proxy moves
+    dragFloatingWindowTo(fw, originalPos + QPoint(100, 100), ButtonAction_Press);
+    QWindow *proxy = DragController::instance()->dragProxyWindow();
+    QVERIFY(proxy);
+    QVERIFY(proxy->isVisible());
+    QCOMPARE(fw->windowHandle()->position(), originalPos);
+    const QPoint proxyPos = proxy->position();
+    QVERIFY(proxyPos != originalPos);
+
+    // Released over the main window but not on a drop indicator, so nothing is docked.
+    // The real window goes where the proxy was
+    releaseOn(originalPos + QPoint(100, 100), draggableFor(fw));
+    QVERIFY(dock1->isFloating());
+    QVERIFY(!DragController::instance()->dragProxyWindow());
+    QCOMPARE(fw->windowHandle()->position(), proxyPos);
+    QCOMPARE(fw->windowHandle()->opacity(), 1.0);
+
+    // Dropping still docks it
+    dragFloatingWindowTo(fw, m->dropArea(), DropLocation_Right);
+    QVERIFY(dock1->isInMainWindow());
+    QVERIFY(!DragController::instance()->dragProxyWindow());
+}
+
+void TestDocks::tst_dragControllerEventFilterBenchmark_data()
+{
+    QTest::addColumn<bool>("pressAndRelease");
+    QTest::newRow("move") << false;
+    QTest::newRow("press-release") << true;
+}
+
+void TestDocks::tst_dragControllerEventFilterBenchmark()
+{
+    // Measures what every mouse event over a title bar pays for the DragController event filter,
+    // with as many draggables registered as a big application would have
+    QFETCH(bool, pressAndRelease);
+
+    EnsureTopLevelsDeleted e;
+    QVector<DockWidgetBase *> docks;
+    for (int i = 0; i < 100; ++i)
+        docks << createDockWidget(QStringLiteral("dock%1").arg(i), new QPushButton(QString::number(i)));
+
+    TitleBar *titleBar = docks.last()->floatingWindow()->titleBar();
+    const QPoint localPos(5, 5);
+    const QPoint globalPos = KDDockWidgets::mapToGlobal(titleBar, localPos);
+    QMouseEvent move(QEvent::MouseMove, localPos, localPos, globalPos,
+                     Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    QMouseEvent press(QEvent::MouseButtonPress, localPos, localPos, globalPos,
+                      Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+    QMouseEvent release(QEvent::MouseButtonRelease, localPos, localPos, globalPos,
+                        Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+
+    if (pressAndRelease) {
+        // The press looks up the draggable, the release cancels the pre-drag
+        QBENCHMARK {
+            qApp->sendEvent(titleBar, &press);
+            qApp->sendEvent(titleBar, &release);
+        }
+    } else {
+        QBENCHMARK {
+            qApp->sendEvent(titleBar, &move);
+        }
+    }
+
+    QVERIFY(DragController::instance()->isIdle());
+}
+
+void TestDocks::tst_appEventOverheadBenchmark_data()
+{
+    QTest::addColumn<int>("numDockWidgets");
+    QTest::newRow("10 docks") << 10;
+    QTest::newRow("100 docks") << 100;
+    QTest::newRow("1000 docks") << 1000;
+}
+
+void TestDocks::tst_appEventOverheadBenchmark()
+{
+    // Measures what any event in the application pays for KDDW's application event filters.
+    // Should stay flat as the number of dock widgets grows.
+    QFETCH(int, numDockWidgets);
+
+    EnsureTopLevelsDeleted e;
+    QVector<DockWidgetBase *> docks;
+    for (int i = 0; i < numDockWidgets; ++i)
+        docks << new DockWidgetType(QStringLiteral("dock%1").arg(i));
+
+    QObject receiver;
+    QEvent ev(QEvent::User);
+    QBENCHMARK {
+        qApp->sendEvent(&receiver, &ev);
+    }
+
+    qDeleteAll(docks);
+}
+
+void TestDocks::tst_windowActivationDispatch()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new QPushButton("1"));
+    auto dock2 = createDockWidget("dock2", new QPushButton("2"));
+    m->addDockWidget(dock1, Location_OnLeft);
+
+    QSignalSpy spy1(dock1, &DockWidgetBase::windowActiveAboutToChange);
+    QSignalSpy spy2(dock2, &DockWidgetBase::windowActiveAboutToChange);
+
+    // Only the dock widgets in the (de)activated window are notified
+    QEvent activate(QEvent::WindowActivate);
+    qApp->sendEvent(dock1->window(), &activate);
+    QCOMPARE(spy1.count(), 1);
+    QVERIFY(spy1.at(0).at(0).toBool());
+    QCOMPARE(spy2.count(), 0);
+
+    QEvent deactivate(QEvent::WindowDeactivate);
+    qApp->sendEvent(dock2->window(), &deactivate);
+    QCOMPARE(spy1.count(), 1);
+    QCOMPARE(spy2.count(), 1);
+    QVERIFY(!spy2.at(0).at(0).toBool());
+}
+
+void TestDocks::tst_mdiResizeController()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(1000, 500), MainWindowOption_HasCentralWidget);
+    auto mdiArea = new MDIArea();
+    m->setPersistentCentralWidget(mdiArea);
+
+    auto mdiWidget1 = createDockWidget("mdi1", new QPushButton("mdi1"));
+    auto mdiWidget2 = createDockWidget("mdi2", new QPushButton("mdi2"));
+    mdiArea->addDockWidget(mdiWidget1, QPoint(10, 10));
+    mdiArea->addDockWidget(mdiWidget2, QPoint(400, 50));
+
+    // All MDI frames share a single resize event filter
+    Frame *frame1 = mdiWidget1->d->frame();
+    MDIResizeController *controller = frame1->mdiLayoutWidget()->resizeController();
+    QVERIFY(controller);
+    QCOMPARE(controller->numHandlers(), 2);
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    // QtQuick's MouseAreas drive the MDI cursor position, so only QtWidgets hit-tests the edges here
+    QVERIFY(Testing::waitForEvent(frame1, QEvent::Show));
+    const int oldWidth = frame1->width();
+    const QPoint localPos(frame1->width() - 2, frame1->height() / 2);
+    const QPoint globalPos = frame1->mapToGlobal(localPos);
+    const QPoint globalDest = globalPos + QPoint(50, 0);
+
+    QMouseEvent press(QEvent::MouseButtonPress, localPos, globalPos,
+                      Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+    qApp->sendEvent(frame1, &press);
+    QVERIFY(frame1->resizeHandler()->isResizing());
+
+    QMouseEvent move(QEvent::MouseMove, frame1->mapFromGlobal(globalDest), globalDest,
+                     Qt::LeftButton, Qt::LeftButton, Qt::NoModifier);
+    qApp->sendEvent(frame1, &move);
+
+    QMouseEvent release(QEvent::MouseButtonRelease, frame1->mapFromGlobal(globalDest), globalDest,
+                        Qt::LeftButton, Qt::NoButton, Qt::NoModifier);
+    qApp->sendEvent(frame1, &release);
+    QVERIFY(!frame1->resizeHandler()->isResizing());
+    QVERIFY(frame1->width() > oldWidth);
+#endif
+
+    // Frames leaving the layout unregister from it
+    mdiWidget2->close();
+    QTRY_COMPARE(controller->numHandlers(), 1);
+}
+
+void TestDocks::tst_focusScopeTracking()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget(QStringLiteral("dock1"), new FocusableWidget());
+    auto dock2 = createDockWidget(QStringLiteral("dock2"), new FocusableWidget());
+    auto dock3 = createDockWidget(QStringLiteral("dock3"), new FocusableWidget());
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom);
+
+    Frame *frame1 = dock1->d->frame();
+    Frame *frame2 = dock2->d->frame();
+    Frame *frame3 = dock3->d->frame();
+
+    dock1->widget()->setFocus(Qt::OtherFocusReason);
+    Testing::waitForEvent(dock1->widget(), QEvent::FocusIn);
+    QVERIFY(frame1->isFocused());
+    QVERIFY(!frame2->isFocused());
+    QCOMPARE(frame1->focusedWidget(), dock1->widget());
+
+    // Moving focus from dock1 to dock2 only notifies their scopes
+    QSignalSpy spy1(frame1, &Frame::isFocusedChanged);
+    QSignalSpy spy2(frame2, &Frame::isFocusedChanged);
+    QSignalSpy spy3(frame3, &Frame::isFocusedChanged);
+    dock2->widget()->setFocus(Qt::OtherFocusReason);
+    Testing::waitForEvent(dock2->widget(), QEvent::FocusIn);
+
+    QVERIFY(!frame1->isFocused());
+    QVERIFY(frame2->isFocused());
+    QVERIFY(!frame3->isFocused());
+    QCOMPARE(spy1.count(), 1);
+    QCOMPARE(spy2.count(), 1);
+    QCOMPARE(spy3.count(), 0);
+
+    // Frame 1 still remembers what was focused in it
+    QCOMPARE(frame1->focusedWidget(), dock1->widget());
+}
+
+void TestDocks::tst_classicIndicatorsHitTest()
+{
+    if (DefaultWidgetFactory::s_dropIndicatorType != DropIndicatorType::Classic)
+        QSKIP("Only relevant for the classic drop indicators");
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget(QStringLiteral("dock1"), new MyWidget(QStringLiteral("one")));
+    auto dock2 = createDockWidget(QStringLiteral("dock2"), new MyWidget(QStringLiteral("two")));
+    auto dock3 = createDockWidget(QStringLiteral("dock3"), new MyWidget(QStringLiteral("three")));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    DropArea *da = m->dropArea();
+    Frame *frame1 = dock1->d->frame();
+    DropIndicatorOverlayInterface *overlay = da->dropIndicatorOverlay();
+    auto draggable = draggableFor(dock3->floatingWindow());
+
+    // Dragging over the frame shows the indicators
+    drag(draggable, KDDockWidgets::mapToGlobal(draggable, QPoint(10, 10)),
+         frame1->mapToGlobal(frame1->rect().center()), ButtonAction_Press);
+    QCOMPARE(overlay->hoveredFrame(), frame1);
+
+    // Each indicator is hit at its reported position, inner and outer ones alike
+    for (DropLocation loc : { DropLocation_Center, DropLocation_Left, DropLocation_Top,
+                              DropLocation_OutterLeft, DropLocation_OutterRight, DropLocation_OutterBottom }) {
+        moveMouseTo(overlay->posForIndicator(loc), draggable);
+        QCOMPARE(overlay->currentDropLocation(), loc);
+    }
+
+    // Leaving the indicators resets the drop location
+    moveMouseTo(frame1->mapToGlobal(frame1->rect().bottomRight() - QPoint(5, 5)), draggable);
+    QCOMPARE(overlay->currentDropLocation(), DropLocation_None);
+
+    drag(draggable, QPoint(), overlay->posForIndicator(DropLocation_Center), ButtonAction_Release);
+    QCOMPARE(dock3->d->frame(), frame1);
+}
+
+void TestDocks::tst_sharedIndicatorWindow()
+{
+    if (DefaultWidgetFactory::s_dropIndicatorType != DropIndicatorType::Classic)
+        QSKIP("Only relevant for the classic drop indicators");
+
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget(QStringLiteral("dock1"), new MyWidget(QStringLiteral("one")));
+    auto dock2 = createDockWidget(QStringLiteral("dock2"), new MyWidget(QStringLiteral("two")));
+    auto dock3 = createDockWidget(QStringLiteral("dock3"), new MyWidget(QStringLiteral("three")));
+    m->addDockWidget(dock1, Location_OnLeft);
+
+    FloatingWindow *fw2 = dock2->floatingWindow();
+    dock2->window()->move(m->mapToGlobal(m->rect().topRight()) + QPoint(100, 0));
+    auto draggable = draggableFor(dock3->floatingWindow());
+    drag(draggable, KDDockWidgets::mapToGlobal(draggable, QPoint(10, 10)),
+         m->mapToGlobal(m->rect().center()), ButtonAction_Press);
+
+    // The same indicator window follows the hovered DropArea
+    for (DropArea *da : { static_cast<DropArea *>(m->dropArea()), fw2->dropArea() }) {
+        Frame *frame = da->frames().constFirst();
+        moveMouseTo(frame->mapToGlobal(frame->rect().center()), draggable);
+        DropIndicatorOverlayInterface *overlay = da->dropIndicatorOverlay();
+        QCOMPARE(overlay->hoveredFrame(), frame);
+        moveMouseTo(overlay->posForIndicator(DropLocation_Center), draggable);
+        QCOMPARE(overlay->currentDropLocation(), DropLocation_Center);
+    }
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    if (!isWayland()) {
+        int numIndicatorWindows = 0;
+        const QWidgetList topLevels = qApp->topLevelWidgets();
+        for (QWidget *topLevel : topLevels) {
+            if (topLevel->objectName() == QLatin1String("_docks_IndicatorWindow_Overlay"))
+                numIndicatorWindows++;
+        }
+
+        QCOMPARE(numIndicatorWindows, 1);
+    }
+
+    // The main window's rubber band isn't shared, it's hidden even though another DropArea is the target now
+    auto rubberBand = m->dropArea()->findChild<QRubberBand *>();
+    QVERIFY(rubberBand);
+    QVERIFY(!rubberBand->isVisible());
+#endif
+
+    drag(draggable, QPoint(), fw2->dropArea()->dropIndicatorOverlay()->posForIndicator(DropLocation_Center), ButtonAction_Release);
+    QCOMPARE(dock3->d->frame(), dock2->d->frame());
+}
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+void TestDocks::tst_segmentedIndicatorsHitTest()
+{
+    EnsureTopLevelsDeleted e;
+    const DropIndicatorType originalType = DefaultWidgetFactory::s_dropIndicatorType;
+    DefaultWidgetFactory::s_dropIndicatorType = DropIndicatorType::Segmented;
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget(QStringLiteral("dock1"), new MyWidget(QStringLiteral("one")));
+    auto dock2 = createDockWidget(QStringLiteral("dock2"), new MyWidget(QStringLiteral("two")));
+    auto dock3 = createDockWidget(QStringLiteral("dock3"), new MyWidget(QStringLiteral("three")));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    DropArea *da = m->dropArea();
+    Frame *frame1 = dock1->d->frame();
+    Frame *frame2 = dock2->d->frame();
+    DropIndicatorOverlayInterface *overlay = da->dropIndicatorOverlay();
+    QVERIFY(qobject_cast<SegmentedIndicators *>(overlay));
+
+    auto draggable = draggableFor(dock3->floatingWindow());
+    drag(draggable, KDDockWidgets::mapToGlobal(draggable, QPoint(10, 10)),
+         frame1->mapToGlobal(frame1->rect().center()), ButtonAction_Press);
+    QCOMPARE(overlay->currentDropLocation(), DropLocation_Center);
+
+    // Going back and forth between segments reuses the cached ones
+    moveMouseTo(da->mapToGlobal(QPoint(5, da->height() / 2)), draggable);
+    QCOMPARE(overlay->currentDropLocation(), DropLocation_OutterLeft);
+    moveMouseTo(frame1->mapToGlobal(frame1->rect().center()), draggable);
+    QCOMPARE(overlay->currentDropLocation(), DropLocation_Center);
+
+    // Hovering another frame rebuilds the inner segments around it
+    moveMouseTo(frame2->mapToGlobal(frame2->rect().center()), draggable);
+    QCOMPARE(overlay->hoveredFrame(), frame2);
+    QCOMPARE(overlay->currentDropLocation(), DropLocation_Center);
+    moveMouseTo(da->mapToGlobal(QPoint(da->width() - 5, da->height() / 2)), draggable);
+    QCOMPARE(overlay->currentDropLocation(), DropLocation_OutterRight);
+
+    drag(draggable, QPoint(), frame2->mapToGlobal(frame2->rect().center()), ButtonAction_Release);
+    QCOMPARE(dock3->d->frame(), frame2);
+
+    m.reset();
+    DefaultWidgetFactory::s_dropIndicatorType = originalType;
+}
+#endif
+
+static QVariant saveGuestName(DockWidgetBase *dw)
+{
+    return dw->widget()->objectName();
+}
+
+static QWidgetOrQuick *createGuestWithName(DockWidgetBase *, const QVariant &state)
+{
+    auto guest = new MyWidget(state.toString());
+    guest->setObjectName(state.toString());
+    return guest;
+}
+
+void TestDocks::tst_guestHibernation()
+{
+    EnsureTopLevelsDeleted e;
+    Config::self().setHibernationBudget(1);
+
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget(QStringLiteral("dock1"), new MyWidget(QStringLiteral("one")));
+    auto dock2 = createDockWidget(QStringLiteral("dock2"), new MyWidget(QStringLiteral("two")));
+    dock1->widget()->setObjectName(QStringLiteral("guest1"));
+    dock2->widget()->setObjectName(QStringLiteral("guest2"));
+    dock1->setHibernationFunctions(saveGuestName, createGuestWithName);
+    dock2->setHibernationFunctions(saveGuestName, createGuestWithName);
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    // Within budget, the closed dock widget keeps its guest
+    QPointer<QObject> guest1 = dock1->widget();
+    dock1->close();
+    QVERIFY(!dock1->isHibernated());
+    QVERIFY(guest1);
+
+    // Over budget, the least recently closed one hibernates
+    dock2->close();
+    QVERIFY(dock1->isHibernated());
+    QVERIFY(!dock1->widget());
+    QVERIFY(!guest1);
+    QVERIFY(!dock2->isHibernated());
+
+    // Showing it again recreates the guest with its saved state
+    dock1->show();
+    QVERIFY(dock1->isOpen());
+    QVERIFY(!dock1->isHibernated());
+    QVERIFY(dock1->widget());
+    QCOMPARE(dock1->widget()->objectName(), QStringLiteral("guest1"));
+
+    // Time based hibernation
+    Config::self().setHibernationBudget(-1);
+    Config::self().setHibernationTimeout(0);
+    dock1->close();
+    QTRY_VERIFY(dock1->isHibernated());
+    dock1->show();
+    QVERIFY(!dock1->isHibernated());
+
+    // Opening cancels pending hibernation
+    Config::self().setHibernationTimeout(100);
+    dock1->close();
+    dock1->show();
+    QTest::qWait(200);
+    QVERIFY(!dock1->isHibernated());
+
+    // So does disabling the timeout
+    dock1->close();
+    Config::self().setHibernationTimeout(-1);
+    QTest::qWait(200);
+    QVERIFY(!dock1->isHibernated());
+}
+
+void TestDocks::tst_tabGuestVirtualization()
+{
+    EnsureTopLevelsDeleted e;
+    Config::self().setMaxLiveTabGuests(2);
+
+    auto m = createMainWindow();
+    DockWidgetBase::List docks;
+    for (int i = 0; i < 4; ++i) {
+        auto dock = createDockWidget(QStringLiteral("dock%1").arg(i), new MyWidget(QStringLiteral("guest")));
+        dock->widget()->setObjectName(QStringLiteral("guest%1").arg(i));
+        dock->setHibernationFunctions(saveGuestName, createGuestWithName);
+        if (docks.isEmpty())
+            m->addDockWidget(dock, Location_OnLeft);
+        else
+            docks.constFirst()->addDockWidgetAsTab(dock);
+        docks.push_back(dock);
+    }
+
+    // The current tab always has its guest
+    for (DockWidgetBase *dock : qAsConst(docks)) {
+        dock->setAsCurrentTab();
+        QVERIFY(!dock->isHibernated());
+        QVERIFY(dock->widget());
+    }
+
+    // Only the two most recently current tabs keep their guest
+    QVERIFY(docks.at(0)->isHibernated());
+    QVERIFY(docks.at(1)->isHibernated());
+    QVERIFY(!docks.at(2)->isHibernated());
+    QVERIFY(!docks.at(3)->isHibernated());
+    QVERIFY(docks.at(0)->isOpen());
+
+    // Going back to a tab recreates its guest, with its state
+    docks.at(0)->setAsCurrentTab();
+    QVERIFY(!docks.at(0)->isHibernated());
+    QCOMPARE(docks.at(0)->widget()->objectName(), QStringLiteral("guest0"));
+    QVERIFY(docks.at(2)->isHibernated());
+    QVERIFY(!docks.at(3)->isHibernated());
+}
+
+void TestDocks::tst_framePool()
+{
+    EnsureTopLevelsDeleted e;
+    Config::self().setFramePoolSize(1);
+
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new MyWidget("one"), {}, {}, /*show=*/false);
+    auto dock2 = createDockWidget("dock2", new MyWidget("two"), {}, {}, /*show=*/false);
+
+    const int missesBefore = Frame::dbg_framePoolMisses();
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    QVERIFY(Frame::dbg_framePoolMisses() > missesBefore);
+
+    // An emptied frame goes into the pool instead of being deleted
+    const int numFrames = Frame::dbg_numFrames();
+    QPointer<Frame> frame2 = dock2->dptr()->frame();
+    dock2->close();
+    QTRY_COMPARE(Frame::dbg_numPooledFrames(), 1);
+    QVERIFY(frame2);
+    QVERIFY(!frame2->isVisible());
+    QCOMPARE(Frame::dbg_numFrames(), numFrames - 1);
+    QVERIFY(!DockRegistry::self()->frames().contains(frame2));
+
+    // And is reused by the next createFrame()
+    const int hitsBefore = Frame::dbg_framePoolHits();
+    m->addDockWidget(dock2, Location_OnRight);
+    QCOMPARE(Frame::dbg_framePoolHits(), hitsBefore + 1);
+    QCOMPARE(Frame::dbg_numPooledFrames(), 0);
+    QCOMPARE(dock2->dptr()->frame(), frame2.data());
+    QCOMPARE(Frame::dbg_numFrames(), numFrames);
+    QVERIFY(DockRegistry::self()->frames().contains(frame2));
+    QVERIFY(dock2->isVisible());
+
+    // Frames beyond the pool size are deleted
+    QPointer<Frame> frame1 = dock1->dptr()->frame();
+    dock2->close();
+    QTRY_COMPARE(Frame::dbg_numPooledFrames(), 1);
+    dock1->close();
+    QVERIFY(Testing::waitForDeleted(frame1));
+    QCOMPARE(Frame::dbg_numPooledFrames(), 1);
+
+    // Shrinking the pool deletes the pooled frames
+    Config::self().setFramePoolSize(0);
+    QCOMPARE(Frame::dbg_numPooledFrames(), 0);
+    QVERIFY(!frame2);
+
+    delete dock1;
+    delete dock2;
+}
+
+void TestDocks::tst_floatingWindowPool()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new MyWidget("one"), {}, {}, /*show=*/false);
+    m->addDockWidget(dock1, Location_OnLeft);
+
+    // The pool is filled once the event loop runs. Pooled windows aren't registered.
+    Config::self().setFloatingWindowPoolSize(1);
+    QCOMPARE(FloatingWindow::dbg_numPooledWindows(), 0);
+    QTRY_COMPARE(FloatingWindow::dbg_numPooledWindows(), 1);
+    QVERIFY(DockRegistry::self()->floatingWindows().isEmpty());
+
+    // Floating claims the pooled window
+    dock1->setFloating(true);
+    QVERIFY(dock1->isFloating());
+    QCOMPARE(FloatingWindow::dbg_numPooledWindows(), 0);
+    FloatingWindow *fw = dock1->floatingWindow();
+    QVERIFY(fw);
+    QVERIFY(fw->isVisible());
+    QCOMPARE(DockRegistry::self()->floatingWindows().size(), 1);
+    QCOMPARE(DockRegistry::self()->floatingWindows().constFirst(), fw);
+    QCOMPARE(fw->dockWidgets().size(), 1);
+
+    // And is replenished later
+    QTRY_COMPARE(FloatingWindow::dbg_numPooledWindows(), 1);
+
+    Config::self().setFloatingWindowPoolSize(0);
+    QCOMPARE(FloatingWindow::dbg_numPooledWindows(), 0);
+}
+
+void TestDocks::tst_layoutSnapshot()
+{
+    EnsureTopLevelsDeleted e;
+    QVERIFY(!LayoutSnapshot::current());
+
+    Config::self().setLayoutSnapshotsEnabled(true);
+    QVERIFY(LayoutSnapshot::current());
+    QCOMPARE(LayoutSnapshot::current()->version(), LayoutSnapshot::currentVersion());
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None, "mw1");
+    auto dock1 = createDockWidget("dock1", new MyWidget("one"));
+    auto dock2 = createDockWidget("dock2", new MyWidget("two"));
+    auto dock3 = createDockWidget("dock3", new MyWidget("three"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    dock1->addDockWidgetAsTab(dock3);
+
+    // Publishing is deferred to the event loop
+    const quint64 version = LayoutSnapshot::currentVersion();
+    QCOMPARE(LayoutSnapshot::current()->version(), version);
+    QTRY_VERIFY(LayoutSnapshot::currentVersion() > version);
+
+    // Readable from another thread
+    LayoutSnapshot::Ptr snapshot;
+    QScopedPointer<QThread> thread(QThread::create([&snapshot] {
+        snapshot = LayoutSnapshot::current();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QVERIFY(snapshot);
+    QCOMPARE(snapshot->frames().size(), 2);
+
+    const LayoutSnapshot::DockWidgetInfo *info1 = snapshot->dockWidget("dock1");
+    const LayoutSnapshot::DockWidgetInfo *info3 = snapshot->dockWidget("dock3");
+    QVERIFY(info1);
+    QVERIFY(info3);
+    QCOMPARE(info1->frameIndex, info3->frameIndex);
+    QVERIFY(!info1->isCurrentTab);
+    QVERIFY(info3->isCurrentTab);
+    QVERIFY(info3->isVisible);
+
+    const LayoutSnapshot::FrameInfo &frame = snapshot->frames().at(info1->frameIndex);
+    QCOMPARE(frame.dockWidgets, QStringList({ "dock1", "dock3" }));
+    QCOMPARE(frame.currentIndex, 1);
+    QCOMPARE(frame.mainWindow, QStringLiteral("mw1"));
+    QCOMPARE(frame.globalGeometry, QRect(dock1->dptr()->frame()->mapToGlobal(QPoint(0, 0)), dock1->dptr()->frame()->QWidgetAdapter::geometry().size()));
+
+    // Frames being resized by the layout publish too
+    Frame *frame2 = dock2->dptr()->frame();
+    const int oldWidth = frame2->QWidgetAdapter::geometry().width();
+    auto publishedWidth = [] {
+        LayoutSnapshot::Ptr current = LayoutSnapshot::current();
+        return current->frames().at(current->dockWidget("dock2")->frameIndex).globalGeometry.width();
+    };
+    m->resize(QSize(1000, 500));
+    QTRY_VERIFY(frame2->QWidgetAdapter::geometry().width() > oldWidth);
+    QTRY_COMPARE(publishedWidth(), frame2->QWidgetAdapter::geometry().width());
+
+    // Published snapshots are immutable
+    dock1->setAsCurrentTab();
+    QTRY_VERIFY(LayoutSnapshot::current()->dockWidget("dock1")->isCurrentTab);
+    QVERIFY(info3->isCurrentTab);
+
+    Config::self().setLayoutSnapshotsEnabled(false);
+    QVERIFY(!LayoutSnapshot::current());
+}
+
+void TestDocks::tst_layoutChanged()
+{
+    EnsureTopLevelsDeleted e;
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget("one"), {}, {}, /*show=*/false);
+    auto dock2 = createDockWidget("dock2", new MyWidget("two"), {}, {}, /*show=*/false);
+    MultiSplitter *layout = m->multiSplitter();
+
+    QVector<LayoutChanges> emissions;
+    connect(layout, &LayoutWidget::layoutChanged, layout, [&emissions](const LayoutChanges &changes) {
+        emissions.push_back(changes);
+    });
+
+    // Coalesced into a single emission
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    QVERIFY(emissions.isEmpty());
+    QTRY_COMPARE(emissions.size(), 1);
+    QCOMPARE(emissions.constFirst().added.size(), 2);
+    QVERIFY(emissions.constFirst().removed.isEmpty());
+
+    Layouting::Item *item1 = layout->itemForFrame(dock1->dptr()->frame());
+    Layouting::Item *item2 = layout->itemForFrame(dock2->dptr()->frame());
+
+    // Moving a separator only changes geometries
+    emissions.clear();
+    Layouting::ItemBoxContainer *root = layout->rootItem();
+    root->requestSeparatorMove(root->separators().constFirst(), 10);
+    QTRY_COMPARE(emissions.size(), 1);
+    QVERIFY(emissions.constFirst().added.isEmpty());
+    QVERIFY(emissions.constFirst().visibilityChanged.isEmpty());
+    QCOMPARE(emissions.constFirst().geometryChanged.size(), 2);
+
+    // Closing leaves a hidden placeholder, and the other item takes its space
+    emissions.clear();
+    dock2->close();
+    QTRY_VERIFY(!item2->isVisible());
+    QTRY_VERIFY(!emissions.isEmpty());
+
+    bool item2Hidden = false;
+    QRect item1Geometry;
+    for (const LayoutChanges &changes : qAsConst(emissions)) {
+        QVERIFY(changes.removed.isEmpty());
+        for (const LayoutChanges::ItemState &state : changes.visibilityChanged) {
+            if (state.item == item2)
+                item2Hidden = !state.isVisible;
+        }
+        for (const LayoutChanges::ItemState &state : changes.geometryChanged) {
+            if (state.item == item1)
+                item1Geometry = state.geometry;
+        }
+    }
+
+    QVERIFY(item2Hidden);
+    QCOMPARE(item1Geometry, item1->mapToRoot(item1->rect()));
+}
+
+void TestDocks::tst_layoutUndo()
+{
+    EnsureTopLevelsDeleted e;
+    LayoutUndoStack *stack = LayoutUndoStack::self();
+    Config::self().setLayoutUndoLimit(10);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None, "mw1");
+    auto dock1 = createDockWidget("dock1", new MyWidget("one"), {}, {}, /*show=*/false);
+    auto dock2 = createDockWidget("dock2", new MyWidget("two"), {}, {}, /*show=*/false);
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    // Floats on its own, none of the operations below touch it
+    auto dock3 = createDockWidget("dock3", new MyWidget("three"));
+    QPointer<FloatingWindow> fw3 = dock3->floatingWindow();
+    QVERIFY(fw3);
+    QVERIFY(!stack->canUndo());
+
+    // Programmatic changes are only recorded when wrapped
+    {
+        LayoutUndoStack::Operation operation;
+        dock2->setFloating(true);
+    }
+    QVERIFY(!stack->canUndo());
+    QTRY_VERIFY(stack->canUndo());
+    QCOMPARE(stack->undoCount(), 1);
+
+    // Operations which don't change anything aren't recorded
+    stack->beginOperation();
+    stack->endOperation();
+    QTest::qWait(10);
+    QCOMPARE(stack->undoCount(), 1);
+
+    QVERIFY(stack->undo());
+    QVERIFY(!dock2->isFloating());
+    QVERIFY(dock2->isVisible());
+    QCOMPARE(m->layoutWidget()->visibleCount(), 2);
+    QVERIFY(!stack->canUndo());
+    QVERIFY(stack->canRedo());
+
+    QVERIFY(stack->redo());
+    QVERIFY(dock2->isFloating());
+    QCOMPARE(m->layoutWidget()->visibleCount(), 1);
+    QVERIFY(stack->canUndo());
+    QVERIFY(!stack->canRedo());
+
+    // Dropping a floating dock widget is recorded
+    dragFloatingWindowTo(dock2->floatingWindow(), m->dropArea(), DropLocation_Right);
+    QVERIFY(!dock2->isFloating());
+    QTRY_COMPARE(stack->undoCount(), 2);
+    QCOMPARE(m->layoutWidget()->visibleCount(), 2);
+
+    QVERIFY(stack->undo());
+    QVERIFY(dock2->isFloating());
+    QCOMPARE(m->layoutWidget()->visibleCount(), 1);
+
+    QVERIFY(stack->redo());
+    QVERIFY(!dock2->isFloating());
+    QCOMPARE(m->layoutWidget()->visibleCount(), 2);
+    QCOMPARE(stack->undoCount(), 2);
+
+    // Only what the steps changed was restored
+    QCOMPARE(dock3->floatingWindow(), fw3.data());
+
+#ifdef KDDOCKWIDGETS_QTWIDGETS
+    // Dragging a separator is recorded too
+    MultiSplitter *layout = m->multiSplitter();
+    QCOMPARE(layout->separators().size(), 1);
+    auto separatorWidget = static_cast<QWidget *>(layout->separators().constFirst()->host());
+    const int oldSeparatorPos = layout->separators().constFirst()->position();
+    const QPoint pressPos = separatorWidget->mapToGlobal(separatorWidget->rect().center());
+    const QPoint releasePos = pressPos + QPoint(50, 0);
+
+    // Spontaneous press, so qApp->mouseButtons() knows the button is down while moving
+    QTest::mousePress(separatorWidget, Qt::LeftButton, Qt::NoModifier, separatorWidget->rect().center());
+    moveMouseTo(releasePos, separatorWidget);
+    QTest::mouseRelease(separatorWidget, Qt::LeftButton, Qt::NoModifier, separatorWidget->mapFromGlobal(releasePos));
+    QCOMPARE(layout->separators().constFirst()->position(), oldSeparatorPos + 50);
+    QTRY_COMPARE(stack->undoCount(), 3);
+
+    QVERIFY(stack->undo());
+    QCOMPARE(layout->separators().constFirst()->position(), oldSeparatorPos);
+    QVERIFY(!dock2->isFloating());
+
+    QVERIFY(stack->redo());
+    QCOMPARE(layout->separators().constFirst()->position(), oldSeparatorPos + 50);
+    QVERIFY(!stack->canRedo());
+#endif
+
+    Config::self().setLayoutUndoLimit(0);
+    QVERIFY(!stack->canUndo());
+    QVERIFY(!stack->canRedo());
+}
+
+void TestDocks::tst_lazyMainWindowResize()
+{
+    EnsureTopLevelsDeleted e;
+    KDDockWidgets::Config::self().setFlags(KDDockWidgets::Config::Flag_LazyMainWindowResize);
+
+    auto m = createMainWindow(QSize(800, 500), MainWindowOption_None);
+    auto dock1 = createDockWidget("dock1", new MyWidget("one"));
+    auto dock2 = createDockWidget("dock2", new MyWidget("two"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+
+    LayoutWidget *layout = m->layoutWidget();
+    Frame *frame2 = dock2->dptr()->frame();
+    QTRY_VERIFY(!layout->hasPendingResize());
+    const QSize oldLayoutSize = layout->size();
+    const QRect oldFrameGeometry = frame2->QWidgetAdapter::geometry();
+
+    // While resizing, the items keep their geometry
+    m->resize(QSize(m->width() + 100, m->height() + 50));
+    QTRY_VERIFY(layout->hasPendingResize());
+    QCOMPARE(layout->size(), oldLayoutSize);
+    QCOMPARE(frame2->QWidgetAdapter::geometry(), oldFrameGeometry);
+
+    // Once resizing pauses, everything is laid out
+    QTRY_VERIFY(!layout->hasPendingResize());
+    QCOMPARE(layout->size(), layout->QWidgetAdapter::size());
+    QVERIFY(frame2->QWidgetAdapter::geometry() != oldFrameGeometry);
+    QVERIFY(layout->checkSanity());
+
+    // Can also be applied immediately
+    m->resize(QSize(m->width() - 100, m->height()));
+    QTRY_VERIFY(layout->hasPendingResize());
+    layout->applyPendingResize();
+    QVERIFY(!layout->hasPendingResize());
+    QCOMPARE(layout->size(), layout->QWidgetAdapter::size());
+    QVERIFY(layout->checkSanity());
+}
+
+#ifdef KDDOCKWIDGETS_QTQUICK
+void TestDocks::tst_qmlComponentCache()
+{
+    EnsureTopLevelsDeleted e;
+    QQmlEngine *engine = Config::self().qmlEngine();
+    const QUrl frameUrl = Config::self().frameworkWidgetFactory()->frameFilename();
+
+    // Components are only parsed once per engine
+    QQmlComponent *component = QWidgetAdapter::cachedComponent(engine, frameUrl);
+    QVERIFY(component);
+    QVERIFY(component->isReady());
+
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new MyWidget("one"), {}, {}, /*show=*/false);
+    auto dock2 = createDockWidget("dock2", new MyWidget("two"), {}, {}, /*show=*/false);
+    m->addDockWidget(dock1, Location_OnLeft);
+
+    // A new frame, with its title bar and tab bar, is created from the already parsed components
+    const int numHits = QWidgetAdapter::dbg_componentCacheHits();
+    const int numMisses = QWidgetAdapter::dbg_componentCacheMisses();
+    m->addDockWidget(dock2, Location_OnRight);
+    QVERIFY(QWidgetAdapter::dbg_componentCacheHits() > numHits);
+    QCOMPARE(QWidgetAdapter::dbg_componentCacheMisses(), numMisses);
+    QCOMPARE(QWidgetAdapter::cachedComponent(engine, frameUrl), component);
+
+    // Components which failed to load aren't cached
+    const QUrl invalidUrl(QStringLiteral("qrc:/kddockwidgets/doesnotexist.qml"));
+    QPointer<QQmlComponent> invalidComponent = QWidgetAdapter::cachedComponent(engine, invalidUrl);
+    QVERIFY(invalidComponent->isError());
+    QVERIFY(QWidgetAdapter::cachedComponent(engine, invalidUrl) != invalidComponent);
+    QTRY_VERIFY(!invalidComponent);
+
+    // Asynchronous guests arrive once incubated. The main window's QQuickView gave the engine
+    // an incubation controller, without it creation would be synchronous.
+    QVERIFY(engine->incubationController());
+    Config::self().setAsynchronousGuestCreation(true);
+    auto dock3 = new DockWidgetType("dock3");
+    dock3->setWidget(QStringLiteral("qrc:/kddockwidgets/private/quick/qml/RubberBand.qml"));
+    QVERIFY(!dock3->widget());
+    QTRY_VERIFY(dock3->widget());
+    Config::self().setAsynchronousGuestCreation(false);
+
+    delete dock3;
+}
+
+void TestDocks::tst_batchedSeparators()
+{
+    EnsureTopLevelsDeleted e;
+    Config::self().setBatchedSeparators(true);
+
+    auto m = createMainWindow();
+    auto dock1 = createDockWidget("dock1", new MyWidget("one"));
+    auto dock2 = createDockWidget("dock2", new MyWidget("two"));
+    auto dock3 = createDockWidget("dock3", new MyWidget("three"));
+    m->addDockWidget(dock1, Location_OnLeft);
+    m->addDockWidget(dock2, Location_OnRight);
+    m->addDockWidget(dock3, Location_OnBottom);
+
+    MultiSplitter *layout = m->multiSplitter();
+    const auto separators = layout->separators();
+    QCOMPARE(separators.size(), 2);
+
+    // All separators are rendered and hit-tested by a single item
+    const auto batches = layout->findChildren<Layouting::SeparatorBatchQuick *>(QString(), Qt::FindDirectChildrenOnly);
+    QCOMPARE(batches.size(), 1);
+    Layouting::SeparatorBatchQuick *batch = batches.constFirst();
+    QCOMPARE(batch->separators().size(), 2);
+
+    for (Layouting::Separator *separator : separators) {
+        const QRect geo = separator->asWidget()->geometry();
+        QVERIFY(batch->contains(geo.center()));
+        QCOMPARE(static_cast<Layouting::Separator *>(batch->separatorAt(geo.center())), separator);
+    }
+
+    // Frames aren't covered
+    QVERIFY(!batch->contains(dock1->dptr()->frame()->QWidgetAdapter::geometry().center()));
+}
+#endif
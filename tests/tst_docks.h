@@ -249,6 +249,27 @@ private Q_SLOTS:
     void tst_setFloatingWindowFlags();
     void tst_crash326();
     void tst_restoreFlagsFromVersion16();
+    void tst_coalesceDragMouseMoves();
+    void tst_dragStatistics();
+    void tst_recordAndReplayInput();
+    void tst_lightweightDragProxy();
+    void tst_dragControllerEventFilterBenchmark_data();
+    void tst_dragControllerEventFilterBenchmark();
+    void tst_appEventOverheadBenchmark_data();
+    void tst_appEventOverheadBenchmark();
+    void tst_windowActivationDispatch();
+    void tst_mdiResizeController();
+    void tst_focusScopeTracking();
+    void tst_classicIndicatorsHitTest();
+    void tst_sharedIndicatorWindow();
+    void tst_guestHibernation();
+    void tst_tabGuestVirtualization();
+    void tst_framePool();
+    void tst_floatingWindowPool();
+    void tst_layoutSnapshot();
+    void tst_layoutChanged();
+    void tst_layoutUndo();
+    void tst_lazyMainWindowResize();
 
 #ifdef KDDOCKWIDGETS_QTWIDGETS
     // TODO: Port these to QtQuick
@@ -278,6 +299,7 @@ private Q_SLOTS:
     void tst_overlayCrash();
     void tst_restoreWithIncompleteFactory();
     void tst_deleteDockWidget();
+    void tst_segmentedIndicatorsHitTest();
 
     // And fix these
     void tst_floatingWindowDeleted();
@@ -295,7 +317,10 @@ private Q_SLOTS:
     void tst_maximumSizePolicy();
     void tst_complex();
     void tst_restoreFloatingMaximizedState();
+    void tst_coalesceLayoutRequests();
 #else
     void tst_hoverShowsDropIndicators();
+    void tst_qmlComponentCache();
+    void tst_batchedSeparators();
 #endif
 };
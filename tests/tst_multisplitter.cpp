@@ -198,6 +198,8 @@ private Q_SLOTS:
     void tst_simplify();
     void tst_adjacentLayoutBorders();
     void tst_numSideBySide_recursive();
+    void tst_incrementalSanityChecks();
+    void tst_visitors();
 };
 
 class MyHostWidget : public QWidget, public Layouting::Widget_qwidget
@@ -1928,6 +1930,139 @@ void TestMultiSplitter::tst_numSideBySide_recursive()
     QCOMPARE(root->numSideBySide_recursive(Qt::Horizontal), 2);
 }
 
+void TestMultiSplitter::tst_incrementalSanityChecks()
+{
+    // Tests that checkSanity() only validates what changed since the last successful check
+    const bool fullSanityChecks = Item::s_fullSanityChecks;
+    Item::s_fullSanityChecks = false;
+
+    auto root = createRoot();
+    auto item1 = createItem();
+    auto item2 = createItem();
+    auto item3 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    ItemBoxContainer::insertItemRelativeTo(item3, item2, Location_OnBottom);
+    ItemBoxContainer *container = item3->parentBoxContainer();
+    QVERIFY(container != root.get());
+
+    QVERIFY(root->needsSanityCheck());
+    QVERIFY(root->checkSanity());
+    QVERIFY(!root->needsSanityCheck());
+    QVERIFY(!container->needsSanityCheck());
+    QVERIFY(!item1->needsSanityCheck());
+    QVERIFY(!item3->needsSanityCheck());
+
+    // Only the changed item and its ancestors need checking
+    item3->setMaxSizeHint(QSize(1000, 1000));
+    QVERIFY(item3->needsSanityCheck());
+    QVERIFY(container->needsSanityCheck());
+    QVERIFY(root->needsSanityCheck());
+    QVERIFY(!item1->needsSanityCheck());
+    QVERIFY(!item2->needsSanityCheck());
+
+    QVERIFY(root->checkSanity());
+    QVERIFY(!root->needsSanityCheck());
+    QVERIFY(!container->needsSanityCheck());
+    QVERIFY(!item3->needsSanityCheck());
+
+    // Full checks validate everything, every time
+    Item::s_fullSanityChecks = true;
+    QVERIFY(item1->needsSanityCheck());
+    QVERIFY(root->checkSanity());
+    Item::s_fullSanityChecks = false;
+
+    {
+        // A container that moves without resizing moves its descendants' guests, so they're validated too
+        auto root2 = createRoot();
+        auto itemA = createItem();
+        auto itemB = createItem(QSize(400, 100));
+        auto itemC = createItem(QSize(400, 100));
+        auto itemD = createItem();
+        root2->insertItem(itemA, Location_OnLeft);
+        root2->insertItem(itemB, Location_OnRight);
+        ItemBoxContainer::insertItemRelativeTo(itemC, itemB, Location_OnBottom);
+        root2->insertItem(itemD, Location_OnRight);
+        ItemBoxContainer *container2 = itemC->parentBoxContainer();
+        QCOMPARE(root2->separators().size(), 2);
+        Separator *separator1 = root2->separators().at(0);
+        Separator *separator2 = root2->separators().at(1);
+
+        // Shrink the container to its minimum, so it can only move
+        root2->requestSeparatorMove(separator2, root2->minPosForSeparator_global(separator2) - separator2->position());
+        QVERIFY(root2->checkSanity());
+
+        const QRect oldContainerGeometry = container2->geometry();
+        root2->requestSeparatorMove(separator1, 10);
+        QCOMPARE(container2->size(), oldContainerGeometry.size());
+        QCOMPARE(container2->x(), oldContainerGeometry.x() + 10);
+        QVERIFY(itemC->needsSanityCheck());
+
+        itemC->guestWidget()->setGeometry(itemC->mapToRoot(itemC->rect()).translated(-10, 0));
+        QVERIFY(!root2->checkSanity());
+    }
+
+    Item::s_fullSanityChecks = fullSanityChecks;
+}
+
+void TestMultiSplitter::tst_visitors()
+{
+    // Tests the allocation-free traversals
+    auto root = createRoot();
+    auto item1 = createItem();
+    auto item2 = createItem();
+    auto item3 = createItem();
+    auto item4 = createItem();
+    root->insertItem(item1, Location_OnLeft);
+    root->insertItem(item2, Location_OnRight);
+    ItemBoxContainer::insertItemRelativeTo(item3, item2, Location_OnBottom);
+    root->insertItem(item4, Location_OnRight);
+    item2->turnIntoPlaceholder();
+
+    // root is: item1 | (item2 placeholder, item3 below it) | item4
+    ItemBoxContainer *container = item3->parentBoxContainer();
+    QVERIFY(container != root.get());
+    QCOMPARE(item2->parentBoxContainer(), container);
+
+    Item::List leaves;
+    QVERIFY(root->forEachLeaf([&leaves](Item *item) {
+        leaves << item;
+        return true;
+    }));
+    QCOMPARE(leaves, Item::List({ item1, item2, item3, item4 }));
+
+    // Returning false stops the traversal
+    leaves.clear();
+    QVERIFY(!root->forEachLeaf([&leaves, item2](Item *item) {
+        leaves << item;
+        return item != item2;
+    }));
+    QCOMPARE(leaves, Item::List({ item1, item2 }));
+
+    Item::List visible;
+    for (Item *item : root->visibleChildrenView())
+        visible << item;
+    QCOMPARE(visible, Item::List({ item1, container, item4 }));
+
+    const VisibleItemsView view = container->visibleChildrenView();
+    QCOMPARE(view.size(), 1);
+    QCOMPARE(view.at(0), item3);
+    QCOMPARE(view.indexOf(item3), 0);
+    QCOMPARE(view.indexOf(item2), -1);
+    QVERIFY(!view.at(1));
+
+    // Only root has separators, one between each of its 3 visible children. The container has a single visible child.
+    QVector<Separator *> separators;
+    root->forEachSeparator_recursive([&separators](Separator *separator) {
+        separators << separator;
+    });
+    QCOMPARE(separators.size(), 2);
+    QCOMPARE(separators.at(0)->position(), item1->x() + item1->width());
+    QCOMPARE(separators.at(1)->position(), container->x() + container->width());
+
+    QVERIFY(root->checkSanity());
+}
+
 int main(int argc, char *argv[])
 {
     bool qpaPassed = false;
@@ -99,6 +99,18 @@ struct EnsureTopLevelsDeleted
         : m_originalFlags(Config::self().flags())
         , m_originalInternalFlags(Config::self().internalFlags())
         , m_originalSeparatorThickness(Config::self().separatorThickness())
+        , m_originalHibernationTimeout(Config::self().hibernationTimeout())
+        , m_originalHibernationBudget(Config::self().hibernationBudget())
+        , m_originalMaxLiveTabGuests(Config::self().maxLiveTabGuests())
+        , m_originalFramePoolSize(Config::self().framePoolSize())
+        , m_originalFloatingWindowPoolSize(Config::self().floatingWindowPoolSize())
+        , m_originalDragStatisticsEnabled(Config::self().dragStatisticsEnabled())
+        , m_originalLayoutSnapshotsEnabled(Config::self().layoutSnapshotsEnabled())
+        , m_originalLayoutUndoLimit(Config::self().layoutUndoLimit())
+#ifdef KDDOCKWIDGETS_QTQUICK
+        , m_originalAsynchronousGuestCreation(Config::self().asynchronousGuestCreation())
+        , m_originalBatchedSeparators(Config::self().batchedSeparators())
+#endif
     {
     }
 
@@ -120,11 +132,35 @@ struct EnsureTopLevelsDeleted
         Config::self().setInternalFlags(m_originalInternalFlags);
         Config::self().setFlags(m_originalFlags);
         Config::self().setSeparatorThickness(m_originalSeparatorThickness);
+        Config::self().setHibernationTimeout(m_originalHibernationTimeout);
+        Config::self().setHibernationBudget(m_originalHibernationBudget);
+        Config::self().setMaxLiveTabGuests(m_originalMaxLiveTabGuests);
+        Config::self().setFramePoolSize(m_originalFramePoolSize);
+        Config::self().setFloatingWindowPoolSize(m_originalFloatingWindowPoolSize);
+        Config::self().setDragStatisticsEnabled(m_originalDragStatisticsEnabled);
+        Config::self().setLayoutSnapshotsEnabled(m_originalLayoutSnapshotsEnabled);
+        Config::self().setLayoutUndoLimit(m_originalLayoutUndoLimit);
+#ifdef KDDOCKWIDGETS_QTQUICK
+        Config::self().setAsynchronousGuestCreation(m_originalAsynchronousGuestCreation);
+        Config::self().setBatchedSeparators(m_originalBatchedSeparators);
+#endif
     }
 
     const Config::Flags m_originalFlags;
     const Config::InternalFlags m_originalInternalFlags;
     const int m_originalSeparatorThickness;
+    const int m_originalHibernationTimeout;
+    const qint64 m_originalHibernationBudget;
+    const int m_originalMaxLiveTabGuests;
+    const int m_originalFramePoolSize;
+    const int m_originalFloatingWindowPoolSize;
+    const bool m_originalDragStatisticsEnabled;
+    const bool m_originalLayoutSnapshotsEnabled;
+    const int m_originalLayoutUndoLimit;
+#ifdef KDDOCKWIDGETS_QTQUICK
+    const bool m_originalAsynchronousGuestCreation;
+    const bool m_originalBatchedSeparators;
+#endif
 };
 
 bool shouldBlacklistWarning(const QString &msg, const QString &category = {});